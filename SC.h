@@ -0,0 +1,1203 @@
+/**************************************************************************************************
+ * If you use this code, please cite
+ * O.T. Courtney and G. Bianconi
+ * "Generalized network structures: the configuration model and the canonical ensemble of
+ * simplicial complexes"
+ * Phys. Rev. E 93, 062311 (2016)
+***************************************************************************************************
+ * Generator of random simplicial complexes of dimension D shared by SC_d1.c, SC_d2.c, SC_d3.c,
+ * SC_d4.c and SC_d5.c. Each of those files sets the parameters and includes this file:
+ *
+ * D  Dimension of the simplices, each simplex has K=D+1 nodes
+ * N, m, gamma2, lambda, Avoid, NX  As described in SC_d1.c
+ * figure  Whether or not the list of edges is printed (figure==1 printed, figure==0 not printed)
+ * both  Whether each edge is printed in both directions (both==1) or once (both==0)
+ * EDGE_FILE  Default name of the file where the list of edges is printed
+ *
+ * D, both and EDGE_FILE are macros. The other parameters are variables, whose values set in SC_dX.c
+ * can be changed when running the code, for instance
+ *     ./SC_d2 N=1000 gamma2=2.2,2.5,3 file=sc.edges
+ * generates three simplicial complexes, in sc_0.edges, sc_1.edges and sc_2.edges (see Set below).
+ * R=100 generates an ensemble of 100 replicas for each point, in sc_r0.edges ... sc_r99.edges, using
+ * as many threads as there are cores (or threads=...). seed=... sets the seed of the random number
+ * generator (SC_random.h), which is printed at the top of every file so that a run can be repeated.
+ * degrees=poisson or degrees=name draw the generalized degrees from a Poisson distribution or from a
+ * distribution read from a file instead of the scale-free one (SC_degrees.h).
+ * binary=1 prints the list of edges in the binary format described in SC_output.h. facets=1 and
+ * faces=1 also print the simplices and their faces of every dimension (SC_faces.h). stats=1 prints
+ * the degree distributions, knn(k) and C(k) averaged over the replicas of each point (SC_stats.h).
+ * canonical=1 generates the canonical ensemble instead of the configuration model (SC_canonical.h).
+ * streaming=1 writes the simplices as they are matched, with file=- to the standard output (see
+ * SC_output.h). Only the table of the simplices and the state of the matching are then kept.
+ * bench=1 checks every replica and prints its timings and counts as JSON (SC_bench.h, bench.sh).
+ * Compiled with -DPROFILE, it also counts the proposals and rejections of the matching and times its
+ * phases, printed on the standard error with progress=t lines every t seconds (SC_profile.h).
+ * Restart and Repair set how a matching that gets stuck is recovered (see Generate), and the number
+ * of restarts and repairs is also printed at the top of every file.
+ * checkpoint=t saves the state of the matching every t seconds, and resume=1 continues the replicas
+ * of an interrupted run from where they were saved, with the same result (SC_checkpoint.h).
+ * relabel=1 numbers the nodes by decreasing desired generalized degree, node 0 being the largest hub,
+ * which keeps the nodes chosen most often by the matching in the same part of memory.
+ * parallel=1 shares the matching of a single large complex among the threads, with the same
+ * distribution of the complexes as the matching one stub at a time (SC_parallel.h).
+ * shuffle=1 matches the stubs by shuffling them all and cutting them into simplices instead of drawing
+ * them one at a time, with the same distribution of the complexes but other complexes (SC_shuffle.h).
+ * store=dir keeps the table of the simplices in memory-mapped files in the directory dir, for complexes
+ * whose table does not fit in memory (SC_store.h).
+ * mcmc=S generates the first replica of each point by the matching and every next one by S swaps of
+ * nodes between simplices from the previous one, keeping the generalized degrees (SC_mcmc.h).
+ * workers=W shares the replicas among W worker processes, and port=P also among workers started on
+ * other machines with coordinator=host:P, with the same files as a single process (SC_coord.h).
+ *
+ * Compiled with -DLIBRARY, the generator is a library instead, which gives each complex in arrays of
+ * the calling program rather than in files (SC_lib.h).
+ *
+ * K is a compile-time constant, so the loops over the nodes of a simplex are unrolled by the
+ * compiler and every dimension gets its own specialized legality check and insertion.
+ *************************************************************************************************/
+
+#define _DEFAULT_SOURCE
+#include<stdio.h>
+#include<stdlib.h>
+#include<string.h>
+#include<limits.h>
+#include<math.h>
+#include<time.h>
+#include<unistd.h>
+#include<fcntl.h>
+#include<pthread.h>
+#include<sys/stat.h>
+#include<sys/mman.h>
+#include<sys/resource.h>
+
+#define K (D+1)
+
+#ifndef both
+#define both 0
+#endif
+#ifndef EDGE_FILE
+#define EDGE_FILE "edge_list.txt"
+#endif
+
+#define MAXPAR 32
+
+extern int N,m,Avoid,NX,figure;
+extern double gamma2;
+
+/* State of the generator. Each thread of an ensemble has its own copy, reused for all its replicas */
+_Thread_local int *kgi,*kg,*tri,nbit,ebits,*sim,sbits,*k,nalloc;
+_Thread_local long long *bit,medge,nedge,*off,ntri,msim,nsim,nrestart,nrepair,nback;
+_Thread_local unsigned long long *edge;
+_Thread_local double *Ck,*knn,*u;
+
+int npar,nval[MAXPAR],R=1,threads=0,Restart=0,Repair=0,binary=0,facets=0,faces=0,stats=0,canonical=0,streaming=0,
+	bench=0,relabel=0;
+long point,npoint,replica,rend;
+unsigned long long seed,stream[4];
+char file[1024],*pname[MAXPAR],*pval[MAXPAR];
+int workers=0,port=0,shard=0;  /* Workers, port and replicas per shard of a coordinator (SC_coord.h) */
+char coordinator[256];  /* host:port of the coordinator of a worker */
+pthread_mutex_t lock=PTHREAD_MUTEX_INITIALIZER;
+
+#include "SC_random.h"
+#include "SC_profile.h"
+#include "SC_degrees.h"
+#include "SC_output.h"
+#include "SC_faces.h"
+#include "SC_stats.h"
+
+/*************************************************************************************************/
+/* Randomly select an unmatched stub. Choose takes as its input a random number between 0 and the
+total number of stubs and gives as its output the index of the node of the selected stub.
+The remaining stubs kgi are stored in a Fenwick tree (bit) so that a stub is selected, removed
+or put back in O(log N) steps instead of scanning all the nodes */
+int Choose(double x){
+	int i=0,step;
+	for(step=nbit;step>0;step>>=1){
+		if((i+step<=N)&&(bit[i+step]<=x)){
+			i+=step;
+			x-=bit[i];
+		}
+	}
+	return(i);
+}
+/*************************************************************************************************/
+/* Build the Fenwick tree from the number of unmatched stubs kgi of every node */
+void Build(){
+	int i,j;
+	for(i=1;i<=N;i++){
+		bit[i]=kgi[i-1];
+	}
+	for(i=1;i<=N;i++){
+		j=i+(i&(-i));
+		if(j<=N){
+			bit[j]+=bit[i];
+		}
+	}
+}
+/*************************************************************************************************/
+/* Add dk unmatched stubs to node i (dk=-1 when a stub is matched, dk=1 when it is put back) */
+void Update(int i, int dk){
+	for(i++;i<=N;i+=i&(-i)){
+		bit[i]+=dk;
+	}
+}
+/*************************************************************************************************/
+/* The links are stored in an open-addressing hash table (edge) of the keys i*N+j+1 with i<j, so that
+the memory needed grows with the number of links instead of N*N. An empty slot holds 0. */
+unsigned long long Key(int i, int j){
+	if(i>j){
+		return((unsigned long long)j*N+i+1);
+	}
+	return((unsigned long long)i*N+j+1);
+}
+/*************************************************************************************************/
+/* Slot of the table where the key is stored, or of the empty slot where it would be stored */
+long long Slot(unsigned long long key){
+	long long s;
+	s=(long long)((key*0x9E3779B97F4A7C15ULL)>>(64-ebits));
+	while((edge[s]!=0)&&(edge[s]!=key)){
+		s=(s+1)&medge;
+	}
+	return(s);
+}
+/*************************************************************************************************/
+/* Create link. Takes two nodes as an input and links them (nothing is done if the link exists) */
+void Link(int i, int j){
+	unsigned long long key;
+	long long s;
+	key=Key(i,j);
+	s=Slot(key);
+	if(edge[s]==0){
+		edge[s]=key;
+		nedge++;
+	}
+}
+/*************************************************************************************************/
+/* Remove all the links. The table is enlarged if needed to hold nmax links at a load factor of at
+most 1/2, and is otherwise reused */
+void Clear(double nmax){
+	int b=4;
+	while((double)(1LL<<b)<2*nmax+1){
+		b++;
+	}
+	if(b>ebits){
+		COUNT(ngrow);
+		free(edge);
+		edge=(unsigned long long*)malloc((1LL<<b)*sizeof(unsigned long long));
+		ebits=b;
+		medge=(1LL<<b)-1;
+	}
+	memset(edge,0,(medge+1)*sizeof(unsigned long long));
+	nedge=0;
+}
+/*************************************************************************************************/
+/* Order of the keys of two links, used to print the links sorted */
+int Compare(const void *x, const void *y){
+	unsigned long long kx=*(const unsigned long long*)x, ky=*(const unsigned long long*)y;
+	return((kx>ky)-(kx<ky));
+}
+/*************************************************************************************************/
+/* Sort the K nodes of a simplex in increasing order, with the optimal sorting network for K<=6 */
+#define Swap(a,b) if(v[a]>v[b]){ t=v[a]; v[a]=v[b]; v[b]=t; }
+void Sort(int *v){
+	int t;
+#if K==2
+	Swap(0,1)
+#elif K==3
+	Swap(0,1) Swap(1,2) Swap(0,1)
+#elif K==4
+	Swap(0,1) Swap(2,3) Swap(0,2) Swap(1,3) Swap(1,2)
+#elif K==5
+	Swap(0,1) Swap(3,4) Swap(2,4) Swap(2,3) Swap(0,3) Swap(0,2) Swap(1,4) Swap(1,3) Swap(1,2)
+#elif K==6
+	Swap(1,2) Swap(4,5) Swap(0,2) Swap(3,5) Swap(0,1) Swap(3,4) Swap(1,4) Swap(0,3) Swap(2,5)
+	Swap(1,3) Swap(2,4) Swap(2,3)
+#else
+	int n,j;
+	for(n=1;n<K;n++){
+		for(j=n;(j>0)&&(v[j-1]>v[j]);j--){
+			t=v[j-1];
+			v[j-1]=v[j];
+			v[j]=t;
+		}
+	}
+#endif
+}
+#undef Swap
+/*************************************************************************************************/
+/* The simplices are stored in an open-addressing hash table (sim) holding, for each simplex, its
+K nodes sorted in increasing order and shifted by one, so that an empty slot holds 0.
+Hash of the shifted simplex u, whose highest bits give the first slot of the table probed for it */
+static inline unsigned long long Hash(const int *u){
+	unsigned long long h=0;
+	int n;
+	for(n=0;n<K;n++){
+		h=(h+(unsigned long long)u[n])*0x9E3779B97F4A7C15ULL;
+	}
+	return(h);
+}
+/*************************************************************************************************/
+/* First slot of the table probed for the shifted simplex u */
+long long SimplexHome(const int *u){
+	return((long long)(Hash(u)>>(64-sbits)));
+}
+/*************************************************************************************************/
+/* Slot of table t (with mask+1 slots) where the shifted simplex u is stored, or of the empty slot
+where it would be stored, probing from slot s */
+static inline long long Probe(const int *t, long long mask, long long s, const int *u){
+	int n,c;
+	while(t[K*s]!=0){
+		c=0;
+		for(n=0;n<K;n++){
+			c|=(t[K*s+n]!=u[n]);
+		}
+		if(c==0){
+			break;
+		}
+		COUNT(nprobe);
+		s=(s+1)&mask;
+	}
+	return(s);
+}
+/*************************************************************************************************/
+/* Slot of the table where the shifted simplex u is stored, or of the empty slot where it would be stored */
+long long SimplexSlot(const int *u){
+	return(Probe(sim,msim,SimplexHome(u),u));
+}
+#include "SC_store.h"
+
+/*************************************************************************************************/
+/* Check if a proposed simplex is legal. Takes the K nodes v as an input and sorts them. Outputs 1
+if two of them coincide or if there already exists a simplex incident to them and 0 otherwise. */
+int Check(int *v){
+	int n,u[K];
+	Sort(v);
+	for(n=1;n<K;n++){
+		if(v[n]==v[n-1]){
+			COUNT(nrepeat);
+			return(1);
+		}
+	}
+	for(n=0;n<K;n++){
+		u[n]=v[n]+1;
+	}
+	if((smapped==1)?Stored(u):(sim[K*SimplexSlot(u)]!=0)){
+		COUNT(nexist);
+		return(1);
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Remove all the simplices from the table, enlarging it if needed to hold nmax simplices at a load
+factor of at most 1/2 */
+void ClearSimplices(double nmax){
+	int b=4;
+	while((double)(1LL<<b)<2*nmax+1){
+		b++;
+	}
+	if((b>sbits)||(smapped!=(store[0]!=0))){
+		COUNT(ngrow);
+		Table(b);
+	}
+	if(smapped==1){
+		ClearStore();
+	}
+	else{
+		memset(sim,0,K*(msim+1)*sizeof(int));
+	}
+	nsim=0;
+}
+/*************************************************************************************************/
+/* The simplices incident to each node are kept in a single arena (tri). Node i owns the entries
+off[i] to off[i+1]-1, one per stub of its desired generalized degree, and each entry holds the slot
+of the simplex in the table, a single 32-bit integer instead of the other D nodes. Layout places the
+lists of the current degree sequence, enlarging the arena only if it is too small. The lists are
+not kept when the simplices are streamed (streaming=1) or the table is kept in files (store=dir) */
+void Layout(){
+	int i;
+	off[0]=0;
+	for(i=0;i<N;i++){
+		off[i+1]=off[i]+kgi[i];
+	}
+	if((off[N]>ntri)&&(streaming==0)&&(store[0]==0)){
+		COUNT(ngrow);
+		ntri=off[N];
+		free(tri);
+		tri=(int*)malloc(ntri*sizeof(int));
+	}
+}
+/*************************************************************************************************/
+/* Create simplex. Takes the K sorted nodes v as an input and creates a simplex incident to them.
+When streaming, the simplex is written instead of being added to the lists of its nodes, and when
+the table is kept in files it is only added to the simplices pending (SC_store.h). */
+void Simplex(const int *v){
+	int n,u[K];
+	long long s=0;
+	for(n=0;n<K;n++){
+		u[n]=v[n]+1;
+	}
+	if(smapped==1){
+		Store(u);
+	}
+	else{
+		s=SimplexSlot(u);
+		memcpy(sim+K*s,u,K*sizeof(int));
+	}
+	nsim++;
+	if(streaming==1){
+		for(n=0;n<K;n++){
+			PutInt(v[n],(n==K-1)?'\n':' ');
+		}
+		return;
+	}
+	for(n=0;(n<K)&&(smapped==0);n++){
+		tri[off[v[n]]+kg[v[n]]-1]=(int)s;
+	}
+}
+/*************************************************************************************************/
+/* Replace slot s by slot t in the list of node i */
+void Move(int i, long long s, long long t){
+	long long e;
+	for(e=off[i];tri[e]!=s;e++);
+	tri[e]=(int)t;
+}
+/*************************************************************************************************/
+/* Delete the simplex stored in slot s of the table. The simplices that follow it are shifted back so
+that none of them is lost to the probing, and with lists==1 their new slot is written in the lists of
+their nodes */
+void Erase(long long s, int lists){
+	int n;
+	long long i;
+	for(i=(s+1)&msim;sim[K*i]!=0;i=(i+1)&msim){
+		if(((i-SimplexHome(sim+K*i))&msim)>=((i-s)&msim)){
+			memcpy(sim+K*s,sim+K*i,K*sizeof(int));
+			for(n=0;(n<K)&&(lists==1);n++){
+				Move(sim[K*s+n]-1,i,s);
+			}
+			s=i;
+		}
+	}
+	memset(sim+K*s,0,K*sizeof(int));
+	nsim--;
+}
+/*************************************************************************************************/
+/* Remove the simplex stored in slot s of the table and put its stubs back, used to repair a matching
+that is stuck. The simplex is removed from the list of each of its nodes by moving the last entry of
+the list in its place */
+void Remove(long long s){
+	int n,v[K];
+	for(n=0;n<K;n++){
+		v[n]=sim[K*s+n]-1;
+		Move(v[n],s,tri[off[v[n]]+kg[v[n]]-1]);
+		kg[v[n]]--;
+		kgi[v[n]]++;
+		Update(v[n],1);
+	}
+	Erase(s,1);
+}
+/*************************************************************************************************/
+/* Create the links of all the simplices, once the matching is complete */
+void Links(){
+	long long s;
+	int n,j,*u;
+	Clear(nsim*K*(K-1)/2.);
+	for(s=0;s<=msim;s++){
+		u=sim+K*s;
+		if(u[0]!=0){
+			for(n=0;n<K;n++){
+				for(j=n+1;j<K;j++){
+					Link(u[n]-1,u[j]-1);
+				}
+			}
+		}
+	}
+}
+/*************************************************************************************************/
+/* Create the links of the simplices and calculate the degrees */
+void Edges(){
+	long long e;
+	int i;
+	PHASE(LINKS);
+	Links();
+	for(i=0;i<N;i++){
+		k[i]=0;
+	}
+	for(e=0;e<=medge;e++){
+		if(edge[e]>0){
+			k[(edge[e]-1)/N]++;
+			k[(edge[e]-1)%N]++;
+		}
+	}
+}
+/*************************************************************************************************/
+/* Maximum possible generalized degree of a node (natural cut-off), the number of ways of choosing
+the other D nodes of a simplex among the other N-1 nodes */
+double Cutoff(){
+	double c=1;
+	int n;
+	for(n=1;n<=D;n++){
+		c=c*(N-n)/n;
+	}
+	if(c>INT_MAX){
+		c=INT_MAX;
+	}
+	return(c);
+}
+#include "SC_canonical.h"
+#include "SC_bench.h"
+#include "SC_checkpoint.h"
+
+/*************************************************************************************************/
+/* Number the nodes by decreasing desired generalized degree (relabel=1), so that the hubs, which are
+chosen most often, are next to each other in kgi, kg and the Fenwick tree and share their cache lines */
+void Relabel(){
+	int i;
+	for(i=0;i<N;i++){
+		ord[i]=((unsigned long long)(INT_MAX-kgi[i])<<32)|(unsigned long long)i;
+	}
+	qsort(ord,N,sizeof(unsigned long long),Compare);
+	for(i=0;i<N;i++){
+		kgi[i]=INT_MAX-(int)(ord[i]>>32);
+	}
+}
+
+/*************************************************************************************************/
+/* Match the stubs until at most K of them are left or NX back-tracks have been made, and output the 
+number of stubs left. Match is inlined once for Avoid==1 and once for Avoid==0, so that each copy 
+is compiled for a fixed value of Avoid. naus back-tracks have already been made, and nrep repairs
+since the matching started, both kept in the checkpoints */
+static inline double Match(double xaus, int avoid, int naus, int nrep){
+	int n,v[K];
+	double x;
+	while((xaus>K)&&(naus<1+avoid*NX)){
+		COUNT(nprop);
+		PROGRESS(xaus,naus);
+		if((journal==1)&&((++nstep&0xFFFF)==0)&&(Now()-tcheck>=checkpoint)){
+			Snapshot(xaus,naus,nrep);
+		}
+		/* Randomly select K nodes proportional to the number of unmatched stubs they have remaining. */
+		for(n=0;n<K;n++){
+			x=xaus*Random();
+			v[n]=Choose(x);
+			kg[v[n]]++;
+			kgi[v[n]]--;
+			Update(v[n],-1);
+			xaus--;
+		}
+
+		/* Check proposed matching is legal */
+		if(Check(v)==0){
+			/* Proposed matching legal. Create simplex */
+			Simplex(v);
+			Journal(1,v,0);
+		}
+		else{
+			/* Proposed matching illegal. Back-track and increment back-track counter by one */
+			naus++;
+			if(avoid==1){
+				for(n=0;n<K;n++){
+					kg[v[n]]--;
+					kgi[v[n]]++;
+					Update(v[n],1);
+				}
+				/* The stubs are unmatched again. The codes of the paper did not add them back to xaus, so
+				that the matching stopped with up to K NX stubs unmatched, and the stubs of the last nodes
+				of the tree could not be drawn */
+				xaus+=K;
+			}
+			else{
+				Journal(2,v,0);
+			}
+		}
+	}
+	nback+=naus;
+	return(xaus);
+}
+#include "SC_parallel.h"
+#include "SC_shuffle.h"
+
+/*************************************************************************************************/
+/* Generate a simplicial complex with the current parameters, and calculate its degrees.
+When the matching gets stuck (NX back-tracks) it is first repaired up to Repair times, each time
+removing a random simplex so that its stubs can be matched with the stuck ones, and then restarted,
+with a new degree sequence (Restart==0) or with the same one (Restart==1). The number of restarts
+and repairs is counted in nrestart and nrepair.
+With the default Repair==0 and Restart==0 the complexes are generated as in the paper cited above, where a
+degree sequence is kept only if it is matched before NX back-tracks, which favours the sequences
+that are easier to match, except that the stubs of a back-track can be drawn again (see Match), so
+that a matching that is not stuck uses every stub. Restart==1 keeps every sequence drawn, so that
+the generalized degrees follow the desired distribution exactly, but hard sequences take longer. A repair changes
+the order in which the stubs are matched, not the degree sequence, and leaves the complexes
+slightly less uniform among those with that sequence, the more so the more repairs are needed. */
+void Generate(){
+	int i,draw,nrep,naus,resumed;
+	long long s;
+	double xaus,cut;
+
+	cut=Cutoff();
+	nrestart=0;
+	nrepair=0;
+	nback=0;
+	draw=1;
+	xaus=K+1;
+	resumed=0;
+	if(canonical==1){
+	/* Canonical ensemble, with hidden variables drawn as the desired generalized degrees */
+		Degrees(cut);
+		if(relabel==1){
+			Relabel();
+		}
+		PHASE(MATCHING);
+		Canonical();
+		xaus=0;
+	}
+	else{
+	/* Matching resumed from its checkpoint (resume=1) */
+		resumed=Restore(&xaus,&naus,&nrep);
+	}
+	while(xaus>K){
+	/***********************************************************************************************/
+	/* Initialization, unless the matching was just resumed */
+		PHASE(INIT);
+		if(resumed==0){
+			if(draw==1){
+			/* Nodes are assigned desired generalized degree according to the distribution set by degrees */
+				Degrees(cut);
+				if(relabel==1){
+					Relabel();
+				}
+				for(i=0;i<N;i++){
+					kg[i]=0;  /* Generalized degree of node i intially set to 0 */
+					k[i]=0;  /* Degree of node i intially set to 0 */
+				}
+			}
+			else{
+			/* The stubs of the same degree sequence are unmatched */
+				for(i=0;i<N;i++){
+					kgi[i]+=kg[i];
+					kg[i]=0;
+					k[i]=0;
+				}
+			}
+			xaus=0;
+			for(i=0;i<N;i++){
+				xaus+=kgi[i];
+			}
+			Build();  /* Fenwick tree of the unmatched stubs */
+			Layout();  /* Empty lists of incident simplices, one entry per stub */
+			ClearSimplices(xaus/K);  /* No simplices */
+			Begin();  /* Journal of the checkpoints started again */
+			naus=0;
+			nrep=0;
+		}
+		resumed=0;
+	/***********************************************************************************************/
+	/* Stubs matched */
+		PHASE(MATCHING);
+		if(Avoid==1){
+			xaus=Deal(xaus,1,naus,nrep);
+			/* Matching repaired. Only possible when back-tracking is allowed, as otherwise the stubs
+			of the illegal matching are already lost */
+			while((xaus>K)&&(nrep<Repair)&&(nsim>0)&&(streaming==0)&&(smapped==0)){
+				do{
+					s=(long long)(Random()*(msim+1));
+				}while(sim[K*s]==0);
+				Journal(3,NULL,s);
+				Remove(s);
+				nrepair++;
+				nrep++;
+				xaus=Deal(xaus+K,1,0,nrep);
+			}
+		}
+		else{
+			xaus=Deal(xaus,0,naus,nrep);
+		}
+		if(xaus>K){
+			nrestart++;
+			draw=(Restart==0);
+			if(streaming==1){
+				Discard();
+			}
+		}
+	}
+	/* The simplices pending are added to the table in files */
+	if(smapped==1){
+		Merge();
+	}
+	/* The links are only needed for the list of edges and the statistics */
+	if((figure==1)||(stats==1)){
+		Edges();
+	}
+}
+#include "SC_mcmc.h"
+
+/*************************************************************************************************/
+/* Allocate the arrays of the nodes. They are only enlarged, so that a sweep reuses them for every 
+point with no more nodes than the largest one seen so far */
+void Allocate(){
+	if(N>nalloc){
+		COUNT(ngrow);
+		kgi=(int*)realloc(kgi,N*sizeof(int));
+		bit=(long long*)realloc(bit,(N+1)*sizeof(long long));
+		kg=(int*)realloc(kg,N*sizeof(int));
+		k=(int*)realloc(k,N*sizeof(int));
+		knn=(double*)realloc(knn,N*sizeof(double));
+		Ck=(double*)realloc(Ck,N*sizeof(double));
+		u=(double*)realloc(u,N*sizeof(double));
+		off=(long long*)realloc(off,(N+1)*sizeof(long long));
+		aoff=(long long*)realloc(aoff,(N+1)*sizeof(long long));
+		ord=(unsigned long long*)realloc(ord,N*sizeof(unsigned long long));
+		nalloc=N;
+	}
+	for(nbit=1;2*nbit<=N;nbit*=2);
+}
+/*************************************************************************************************/
+/* Free the arrays of the thread, when it has generated all its replicas */
+void Release(){
+	free(kgi);
+	free(bit);
+	free(kg);
+	free(k);
+	free(knn);
+	free(Ck);
+	free(u);
+	free(off);
+	free(aoff);
+	free(adj);
+	free(ord);
+	free(cs);
+	free(jop);
+	free(taken);
+	free(drawn);
+	free(touch);
+	free(pseed);
+	free(first);
+	free(stub);
+	free(spare);
+	free(label);
+	free(scount);
+	free(sseed);
+	free(tri);
+	ReleaseStore();
+	free(edge);
+	ReleaseWriter();
+	nalloc=0;
+	ntri=0;
+	nadj=0;
+	mcs=0;
+	mjop=0;
+	mdrawn=0;
+	mpseed=0;
+	ntaken=0;
+	mfirst=0;
+	nstub=0;
+	mscount=0;
+	sbits=0;
+	ebits=0;
+}
+/*************************************************************************************************/
+/* Print list of edges to file, after a line starting with # with the parameters and the seed that
+generated them (head). The links are taken from the table, sorted, and written through the buffered
+writer of SC_output.h, as text or, with binary=1, in its binary format */
+void Print(const char *name, const char *head){
+	long long e,ne,nb;
+	unsigned long long *list,prev,x;
+
+	list=(unsigned long long*)malloc((2*nedge+1)*sizeof(unsigned long long));
+	ne=0;
+	for(e=0;e<=medge;e++){
+		if(edge[e]>0){
+			list[ne++]=edge[e]-1;
+			if((both==1)&&(binary==0)){
+				list[ne++]=((edge[e]-1)%N)*N+(edge[e]-1)/N;
+			}
+		}
+	}
+	qsort(list,ne,sizeof(unsigned long long),Compare);
+	Open(name);
+	if(binary==0){
+		Put(head,strlen(head));
+		for(e=0;e<ne;e++){
+			PutInt(list[e]/N,' ');
+			PutInt(list[e]%N,'\n');
+		}
+	}
+	else{
+		x=strlen(head);
+		Put("SCEDGES1",8);
+		Put(&x,8);
+		Put(head,x);
+		Pad();
+		x=N;
+		Put(&x,8);
+		x=ne;
+		Put(&x,8);
+		nb=0;
+		prev=0;
+		for(e=0;e<ne;e++){
+			nb+=VarintLength(list[e]-prev);
+			prev=list[e];
+		}
+		Put(&nb,8);
+		prev=0;
+		for(e=0;e<ne;e++){
+			PutVarint(list[e]-prev);
+			prev=list[e];
+		}
+	}
+	Close();
+	free(list);
+}
+/*************************************************************************************************/
+/* The parameters set in SC_dX.c are default values. They can be changed when running the code with
+arguments name=value, or with a file of such lines (lines starting with # are ignored) given as an
+argument. A parameter given a comma-separated list of values is swept: a simplicial complex is
+generated for every combination of the values of the swept parameters, in the same run.
+Set parameter name to value. Outputs 0 if the parameter exists and 1 otherwise */
+int Set(const char *name, const char *value){
+#ifndef PROFILE
+	static int nwarn=0;  /* Warnings that progress is ignored */
+#endif
+	if(strcmp(name,"N")==0){
+		N=atoi(value);
+	}
+	else if(strcmp(name,"m")==0){
+		m=atoi(value);
+	}
+	else if(strcmp(name,"gamma2")==0){
+		gamma2=atof(value);
+	}
+	else if(strcmp(name,"lambda")==0){
+		lambda=atof(value);
+	}
+	else if(strcmp(name,"degrees")==0){
+		snprintf(degrees,sizeof(degrees),"%s",value);
+	}
+	else if(strcmp(name,"Avoid")==0){
+		Avoid=atoi(value);
+	}
+	else if(strcmp(name,"NX")==0){
+		NX=atoi(value);
+	}
+	else if(strcmp(name,"figure")==0){
+		figure=atoi(value);
+	}
+	else if(strcmp(name,"Restart")==0){
+		Restart=atoi(value);
+	}
+	else if(strcmp(name,"Repair")==0){
+		Repair=atoi(value);
+	}
+	else if(strcmp(name,"mcmc")==0){
+		mcmc=atoll(value);
+	}
+	else if(strcmp(name,"shuffle")==0){
+		shuffle=atoi(value);
+	}
+	else if(strcmp(name,"parallel")==0){
+		parallel=atoi(value);
+	}
+	else if(strcmp(name,"relabel")==0){
+		relabel=atoi(value);
+	}
+	else if(strcmp(name,"checkpoint")==0){
+		checkpoint=atof(value);
+	}
+	else if(strcmp(name,"resume")==0){
+		resume=atoi(value);
+	}
+	else if(strcmp(name,"progress")==0){
+		progress=atof(value);
+#ifndef PROFILE
+		if((progress>0)&&(nwarn++==0)){
+			fprintf(stderr,"progress=%s is ignored, the codes are not compiled with -DPROFILE\n",value);
+		}
+#endif
+	}
+	else if(strcmp(name,"binary")==0){
+		binary=atoi(value);
+	}
+	else if(strcmp(name,"facets")==0){
+		facets=atoi(value);
+	}
+	else if(strcmp(name,"faces")==0){
+		faces=atoi(value);
+	}
+	else if(strcmp(name,"stats")==0){
+		stats=atoi(value);
+	}
+	else if(strcmp(name,"canonical")==0){
+		canonical=atoi(value);
+	}
+	else if(strcmp(name,"streaming")==0){
+		streaming=atoi(value);
+	}
+	else if(strcmp(name,"bench")==0){
+		bench=atoi(value);
+	}
+	else if(strcmp(name,"R")==0){
+		R=atoi(value);
+	}
+	else if(strcmp(name,"threads")==0){
+		threads=atoi(value);
+	}
+	else if(strcmp(name,"seed")==0){
+		seed=strtoull(value,NULL,10);
+	}
+	else if(strcmp(name,"store")==0){
+		snprintf(store,sizeof(store),"%s",value);
+	}
+	else if(strcmp(name,"workers")==0){
+		workers=atoi(value);
+	}
+	else if(strcmp(name,"port")==0){
+		port=atoi(value);
+	}
+	else if(strcmp(name,"shard")==0){
+		shard=atoi(value);
+	}
+	else if(strcmp(name,"coordinator")==0){
+		snprintf(coordinator,sizeof(coordinator),"%s",value);
+	}
+	else if(strcmp(name,"file")==0){
+		snprintf(file,sizeof(file),"%s",value);
+	}
+	else{
+		return(1);
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Value number j of the comma-separated list of parameter a. The value is copied in a static buffer */
+const char *Value(int a, int j){
+	static char buf[256];
+	const char *c=pval[a];
+	int n=0;
+	for(;j>0;c++){
+		if(*c==','){
+			j--;
+		}
+	}
+	while((c[n]!=0)&&(c[n]!=',')&&(n<255)){
+		buf[n]=c[n];
+		n++;
+	}
+	buf[n]=0;
+	return(buf);
+}
+/*************************************************************************************************/
+/* Store an argument name=value[,value...]. Outputs the number of values */
+int Argument(const char *arg){
+	char *s,*c;
+	s=strdup(arg);
+	c=strchr(s,'=');
+	if((c==NULL)||(npar==MAXPAR)){
+		fprintf(stderr,"Bad argument %s, parameters are set with name=value\n",arg);
+		exit(1);
+	}
+	*c=0;
+	pname[npar]=s;
+	pval[npar]=c+1;
+	nval[npar]=1;
+	for(c++;*c!=0;c++){
+		nval[npar]+=(*c==',');
+	}
+	if(Set(s,Value(npar,0))==1){
+		fprintf(stderr,"Unknown parameter %s\n",s);
+		exit(1);
+	}
+	return(nval[npar++]);
+}
+/*************************************************************************************************/
+/* Read the arguments, from the command line or from the files given on the command line. Outputs the
+number of points of the sweep */
+long Arguments(int argc, char **argv){
+	int a;
+	long np=1;
+	char line[4096],*c;
+	FILE *fp;
+	for(a=1;a<argc;a++){
+		if(strchr(argv[a],'=')!=NULL){
+			np*=Argument(argv[a]);
+		}
+		else{
+			fp=fopen(argv[a],"r");
+			if(fp==NULL){
+				fprintf(stderr,"Cannot open %s\n",argv[a]);
+				exit(1);
+			}
+			while(fgets(line,sizeof(line),fp)!=NULL){
+				for(c=line;*c!=0;c++){
+					if((*c=='\n')||(*c=='\r')||(*c==' ')||(*c=='\t')){
+						*c=0;
+						break;
+					}
+				}
+				if((line[0]!=0)&&(line[0]!='#')){
+					np*=Argument(line);
+				}
+			}
+			fclose(fp);
+		}
+	}
+	return(np);
+}
+/*************************************************************************************************/
+/* Set the parameters of point p of the sweep */
+void Point(long p){
+	int a;
+	for(a=0;a<npar;a++){
+		Set(pname[a],Value(a,p%nval[a]));
+		p/=nval[a];
+	}
+}
+/*************************************************************************************************/
+/* Take the next replica of the current point, and set the generator of the thread to its stream.
+Replicas are taken in order, and each stream starts 2^128 numbers after the previous one, so that
+a replica is the same whichever thread generates it. Outputs -1 when the replicas before rend are taken */
+long Take(){
+	long r=-1;
+	pthread_mutex_lock(&lock);
+	if(replica<rend){
+		r=replica++;
+		memcpy(rs,stream,sizeof(stream));
+		Jump(stream);
+	}
+	pthread_mutex_unlock(&lock);
+	return(r);
+}
+/*************************************************************************************************/
+/* Line starting with # with the parameters of the current point and the seed, heading the files
+printed. For replica r (r>=0) it ends with the number of restarts and repairs if counts==1, and
+otherwise with the number of replicas */
+void Header(char *head, size_t n, long r, int counts){
+	snprintf(head,n,"# D=%d N=%d canonical=%d degrees=%s relabel=%d parallel=%d shuffle=%d mcmc=%lld m=%d "
+		"gamma2=%g lambda=%g Avoid=%d NX=%d Restart=%d Repair=%d seed=%llu point=%ld",D,N,canonical,degrees,relabel,
+		parallel,shuffle,mcmc,m,gamma2,lambda,Avoid,NX,Restart,Repair,seed,point);
+	if((r>=0)&&(counts==1)){
+		snprintf(head+strlen(head),n-strlen(head)," replica=%ld restarts=%lld repairs=%lld\n",r,nrestart,
+			nrepair);
+	}
+	else if(r>=0){
+		snprintf(head+strlen(head),n-strlen(head)," replica=%ld\n",r);
+	}
+	else{
+		snprintf(head+strlen(head),n-strlen(head)," replicas=%d\n",R);
+	}
+}
+/*************************************************************************************************/
+/* Name of the files of replica r (r>=0) or of the current point (r<0), without extension. In a sweep
+the index of the point, and in an ensemble the index of the replica, are added to the name of the
+file. Outputs the extension of the name of the file */
+const char *Stem(char *name, size_t n, long r){
+	const char *dot;
+	dot=strrchr(file,'.');
+	if((dot==NULL)||(strchr(dot,'/')!=NULL)){
+		dot=file+strlen(file);
+	}
+	snprintf(name,n,"%.*s",(int)(dot-file),file);
+	if(npoint>1){
+		snprintf(name+strlen(name),n-strlen(name),"_%ld",point);
+	}
+	if((R>1)&&(r>=0)){
+		snprintf(name+strlen(name),n-strlen(name),"_r%ld",r);
+	}
+	return(dot);
+}
+/*************************************************************************************************/
+/* Generate replica r of the current point, print it, and add its statistics to those of the point.
+The facets and the faces are printed in files with the same name as the list of edges and the
+extensions .facets and .faces. With file=- they are all printed to the standard output instead, every
+replica of every point after its header line */
+void Replica(long r){
+	char name[sizeof(file)+64],head[sizeof(degrees)+512];
+	const char *dot;
+	size_t l;
+	int out=(strcmp(file,"-")==0);
+	struct timespec t0,t1;
+	START();
+	Allocate();
+	ckname[0]=0;
+	journal=0;
+	if((canonical==0)&&(streaming==0)&&((checkpoint>0)||(resume==1))){
+	/* The matching is checkpointed in, and resumed from, the file name.ckpt */
+		Header(ckhead,sizeof(ckhead),r,0);
+		Stem(ckname,sizeof(ckname),r);
+		snprintf(ckname+strlen(ckname),sizeof(ckname)-strlen(ckname),".ckpt");
+		journal=(checkpoint>0);
+	}
+	if(streaming==1){
+	/* The simplices are written as they are matched, after the line head */
+		Header(head,sizeof(head),r,0);
+		Stem(name,sizeof(name),r);
+		snprintf(name+strlen(name),sizeof(name)-strlen(name),".facets");
+		Open((out==1)?"-":name);
+		Put(head,strlen(head));
+		Commit();
+	}
+	clock_gettime(CLOCK_MONOTONIC,&t0);
+	if((mcmc>0)&&(streaming==0)&&(store[0]==0)){
+		Chain(r);
+	}
+	else{
+		Generate();
+	}
+	clock_gettime(CLOCK_MONOTONIC,&t1);
+	if(bench==1){
+		Report(r,(t1.tv_sec-t0.tv_sec)+1e-9*(t1.tv_nsec-t0.tv_nsec));
+	}
+	if(streaming==1){
+		snprintf(head,sizeof(head),"# end point=%ld replica=%ld simplices=%lld restarts=%lld repairs=%lld\n",point,r,
+			nsim,nrestart,nrepair);
+		Put(head,strlen(head));
+		Close();
+	}
+	PHASE(ANALYSIS);
+	if(stats==1){
+		Analyse();
+	}
+	PHASE(OUTPUT);
+	if((figure==1)||(facets==1)||(faces==1)){
+		Header(head,sizeof(head),r,1);
+		dot=Stem(name,sizeof(name),r);
+		l=strlen(name);
+		if((facets==1)&&(streaming==0)){
+			snprintf(name+l,sizeof(name)-l,".facets");
+			PrintFacets((out==1)?"-":name,head);
+		}
+		if(faces==1){
+			snprintf(name+l,sizeof(name)-l,".faces");
+			PrintFaces((out==1)?"-":name,head);
+		}
+		if(figure==1){
+			snprintf(name+l,sizeof(name)-l,"%s",dot);
+			Print((out==1)?"-":name,head);
+		}
+	}
+	if(ckname[0]!=0){
+		remove(ckname);
+	}
+	Profile(r);
+}
+/*************************************************************************************************/
+/* Exit if the parameters of the current point are bad */
+void Valid(){
+	if((N<=K)||(m<1)||(gamma2<=1)||(lambda<=0)||(NX<0)||(R<1)){
+		fprintf(stderr,"Bad parameters N=%d m=%d gamma2=%g lambda=%g NX=%d R=%d\n",N,m,gamma2,lambda,NX,R);
+		exit(1);
+	}
+}
+/*************************************************************************************************/
+/* Thread of an ensemble. The replicas of the current point are handed out one at a time to the
+threads, so that a thread that finishes early takes the next one */
+void *Worker(void *arg){
+	long r;
+	(void)arg;
+	while((r=Take())>=0){
+		Replica(r);
+	}
+	Release();
+	return(NULL);
+}
+/*************************************************************************************************/
+/* Generate the replicas replica to rend-1 of the current point, whose streams follow stream, and add
+their statistics to the sums of the point */
+void Replicas(){
+	int t,nt;
+	long r;
+	pthread_t *tid;
+	nt=(rend-replica<threads)?(int)(rend-replica):threads;
+	if(strcmp(file,"-")==0){
+	/* The replicas printed to the standard output are generated one at a time */
+		nt=1;
+	}
+	if(mcmc>0){
+	/* The replicas of a chain are generated one after the other */
+		nt=1;
+	}
+	inner=(nt<=1)?threads:1;  /* Threads sharing the analysis of a replica */
+	ClearStats();
+	if(nt<=1){
+		while((r=Take())>=0){
+			Replica(r);
+		}
+	}
+	else{
+	/* Ensemble generated by nt threads, each with its own arrays and random number generator */
+		tid=(pthread_t*)malloc(nt*sizeof(pthread_t));
+		for(t=0;t<nt;t++){
+			pthread_create(&tid[t],NULL,Worker,NULL);
+		}
+		for(t=0;t<nt;t++){
+			pthread_join(tid[t],NULL);
+		}
+		free(tid);
+	}
+}
+/*************************************************************************************************/
+/* Print the statistics (ext .stats) or the diagnostics of the chain (ext .mcmc) of the current point */
+void Summary(const char *ext){
+	char name[sizeof(file)+64],head[sizeof(degrees)+512];
+	Header(head,sizeof(head),-1,0);
+	Stem(name,sizeof(name),-1);
+	snprintf(name+strlen(name),sizeof(name)-strlen(name),"%s",ext);
+	if(strcmp(ext,".stats")==0){
+		PrintStats(name,head);
+	}
+	else{
+		PrintChain(name,head);
+	}
+}
+#include "SC_lib.h"
+#include "SC_coord.h"
+
+/*************************************************************************************************/
+#ifndef LIBRARY
+
+int main(int argc, char** argv){
+	struct timespec ts;
+
+	/* The default seed differs between runs started at the same time */
+	clock_gettime(CLOCK_REALTIME,&ts);
+	seed=(unsigned long long)ts.tv_sec*1000000007ULL^(unsigned long long)ts.tv_nsec^((unsigned long long)getpid()<<32);
+	snprintf(file,sizeof(file),"%s",EDGE_FILE);
+	npoint=Arguments(argc,argv);
+	if(threads<=0){
+		threads=(int)sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	if(coordinator[0]!=0){
+	/* Worker of a coordinator, possibly on another machine, which sends the parameters */
+		Serve(-1);
+		return 0;
+	}
+	if((workers>0)||(port>0)){
+	/* Ensemble shared among worker processes */
+		Coordinate();
+		return 0;
+	}
+	Seed(stream,seed);
+
+	for(point=0;point<npoint;point++){
+		Point(point);
+		Valid();
+		Distribution(Cutoff());
+		if((npoint>1)&&(bench==0)){
+		/* On the standard error when the complexes are printed to the standard output */
+			fprintf((strcmp(file,"-")==0)?stderr:stdout,"%ld N=%d m=%d gamma2=%g Avoid=%d NX=%d\n",point,N,m,gamma2,
+				Avoid,NX);
+		}
+		replica=0;
+		rend=R;
+		Replicas();
+		if(stats==1){
+			Summary(".stats");
+		}
+		if((mcmc>0)&&(streaming==0)&&(store[0]==0)){
+			Summary(".mcmc");
+		}
+	}
+
+	return 0;
+}
+#endif
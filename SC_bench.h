@@ -0,0 +1,74 @@
+/**************************************************************************************************
+ * Benchmark mode of SC.h (bench=1), run over a grid of parameters by bench.sh. For every replica it
+ * checks the complex generated and prints one line of JSON on the standard output with
+ *
+ * D, N, gamma2, seed, point, replica  The parameters of the replica
+ * time  Wall time taken by the generation, in seconds
+ * simplices  Number of simplices generated
+ * throughput  Simplices generated per second
+ * rss  Peak resident memory of the process so far, in kB
+ * restarts, backtracks, repairs  Number of restarts, back-tracks and repairs of the matching
+ * valid  Whether the complex passed the checks below
+ *
+ * The checks are that every simplex has K different nodes, that no simplex is stored twice, that the
+ * generalized degree of every node is the number of simplices incident to it, that the list of
+ * every node holds the slots of simplices incident to it, and, for the configuration model, that at
+ * most K stubs were left unmatched so that the generalized degrees are the desired ones.
+ *************************************************************************************************/
+
+/*************************************************************************************************/
+/* Check the complex just generated. Outputs 1 if it is valid and 0 otherwise */
+int Validate(){
+	int n,j,*c,ok=1;
+	long long s,e,left;
+	c=(int*)calloc(N,sizeof(int));
+	for(s=0;s<=msim;s++){
+		if(sim[K*s]!=0){
+			for(n=0;n<K;n++){
+				if((sim[K*s+n]<1)||(sim[K*s+n]>N)||((n>0)&&(sim[K*s+n]<=sim[K*s+n-1]))){
+					ok=0;
+				}
+				else{
+					c[sim[K*s+n]-1]++;
+				}
+			}
+			/* A copy of the simplex stored earlier in the table would be found first */
+			if(SimplexSlot(sim+K*s)!=s){
+				ok=0;
+			}
+		}
+	}
+	left=0;
+	for(n=0;n<N;n++){
+		if(c[n]!=kg[n]){
+			ok=0;
+		}
+		left+=kgi[n];
+		for(e=off[n];(e<off[n]+kg[n])&&(streaming==0)&&(smapped==0);e++){
+			for(j=0;(j<K)&&(sim[K*(long long)tri[e]+j]!=n+1);j++);
+			if(j==K){
+				ok=0;
+			}
+		}
+	}
+	if((canonical==0)&&(left>K)){
+		ok=0;
+	}
+	free(c);
+	return(ok);
+}
+/*************************************************************************************************/
+/* Print the line of JSON of replica r, generated in t seconds */
+void Report(long r, double t){
+	struct rusage ru;
+	int ok;
+	ok=Validate();
+	getrusage(RUSAGE_SELF,&ru);
+	pthread_mutex_lock(&lock);
+	printf("{\"D\": %d, \"N\": %d, \"gamma2\": %g, \"seed\": %llu, \"point\": %ld, \"replica\": %ld, "
+		"\"time\": %.6f, \"simplices\": %lld, \"throughput\": %.1f, \"rss\": %ld, \"restarts\": %lld, "
+		"\"backtracks\": %lld, \"repairs\": %lld, \"valid\": %s}\n",D,N,gamma2,seed,point,r,t,nsim,
+		(t>0)?nsim/t:0,ru.ru_maxrss,nrestart,nback,nrepair,(ok==1)?"true":"false");
+	fflush(stdout);
+	pthread_mutex_unlock(&lock);
+}
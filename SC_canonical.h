@@ -0,0 +1,245 @@
+/**************************************************************************************************
+ * Canonical ensemble of simplicial complexes (Phys. Rev. E 93, 062311 (2016)), generated by SC.h
+ * instead of the configuration model when canonical=1.
+ *
+ * Each node i has a hidden variable theta_i, its expected generalized degree, drawn from the
+ * distribution set by degrees (SC_degrees.h). Each of the possible simplices of K=D+1 nodes is then
+ * included independently with probability
+ *     p = min(1, D! theta_i0 ... theta_iD / (<theta> N)^D),
+ * so that the average generalized degree of node i is close to theta_i as long as p<<1.
+ *
+ * Going through all the C(N,K) possible simplices would take O(N^K) steps. Instead the nodes are sorted
+ * by decreasing theta and divided in groups in which theta changes by less than a factor 2. For every
+ * choice of K groups (with repetitions) the probability of all the simplices with a node in each of
+ * them is bounded by the probability pmax of the one with the largest hidden variables, so that the
+ * candidates are drawn with probability pmax by skipping over a geometrically distributed number of
+ * them, and each candidate drawn is kept with probability p/pmax. The number of steps is of the order
+ * of the number of simplices generated times at most 2^K, plus the number of choices of groups.
+ *
+ * The candidates of a choice of groups are numbered as the mixed-radix combination of a subset of
+ * each group, so that every simplex is a candidate exactly once. There can be more than 2^64 of them,
+ * and they are numbered with the 128-bit integers of gcc and clang. As the candidates of any choice
+ * of groups are at most the C(N,K) possible simplices, the complex is only generated if C(N,K) fits in
+ * 128 bits, which only excludes D=5 with more than about 5 10^6 nodes. canonical.sh checks the average
+ * generalized degrees against those computed by going through all the simplices of small complexes.
+ *************************************************************************************************/
+
+#define MAXGROUP 64  /* Largest number of groups of nodes */
+#define BIG (~(unsigned __int128)0)  /* Binomial coefficient too large */
+
+_Thread_local unsigned long long *ord;  /* Nodes sorted by decreasing hidden variable */
+_Thread_local int *cs;  /* Nodes of the simplices drawn */
+_Thread_local long long ncs,mcs;
+
+/*************************************************************************************************/
+/* Binomial coefficient C(n,r), or BIG if it does not fit in 128 bits. C(n,t+1)=C(n,t)(n-t)/(t+1) is
+computed without overflow by dividing first C(n,t) and t+1 by their greatest common divisor g, as
+(t+1)/g then divides n-t */
+unsigned __int128 Binomial(long long n, int r){
+	unsigned __int128 c=1;
+	long long a,b,x,g;
+	int t;
+	if(n<r){
+		return(0);
+	}
+	for(t=0;t<r;t++){
+		a=t+1;
+		b=(long long)(c%a);
+		for(g=a;b!=0;x=g%b,g=b,b=x);
+		if(__builtin_mul_overflow(c/g,(unsigned __int128)((n-t)/(a/g)),&c)){
+			return(BIG);
+		}
+	}
+	return(c);
+}
+/*************************************************************************************************/
+/* Subset number idx of r elements of 0 to n-1, in colexicographic order, as r increasing elements w.
+Each element is the largest c with C(c,j)<=idx, estimated from C(c,j)~(c-(j-1)/2)^j/j! and corrected */
+void Unrank(unsigned __int128 idx, long long n, int r, long long *w){
+	int j,t;
+	long long c;
+	double f;
+	for(j=r;j>=1;j--){
+		if(j==1){
+			w[0]=(long long)idx;
+			break;
+		}
+		f=1;
+		for(t=2;t<=j;t++){
+			f*=t;
+		}
+		c=(long long)(pow((double)idx*f,1./j)+(j-1)/2.);
+		if(c>n-1){
+			c=n-1;
+		}
+		if(c<j-1){
+			c=j-1;
+		}
+		while((c<n-1)&&(Binomial(c+1,j)<=idx)){
+			c++;
+		}
+		while(Binomial(c,j)>idx){
+			c--;
+		}
+		w[j-1]=c;
+		idx-=Binomial(c,j);
+		n=c;
+	}
+}
+/*************************************************************************************************/
+/* Draw the simplices of choice g of K groups (in increasing order), whose nodes start at position
+gs[] of ord and number gn[]. theta holds the hidden variables and scale the factor D!/(<theta> N)^D */
+void Candidates(const int *g, const long long *gs, const long long *gn, const double *theta, double scale){
+	int n,b,nb,j,r[K],v[K];
+	long long bs[K],bn[K],w[K];
+	unsigned __int128 c[K],t,pos,idx;
+	double pmax,p,s,lq;
+
+	/* Blocks of equal groups, and number of candidates t */
+	nb=0;
+	for(n=0;n<K;n++){
+		if((n==0)||(g[n]!=g[n-1])){
+			bs[nb]=gs[g[n]];
+			bn[nb]=gn[g[n]];
+			r[nb]=0;
+			nb++;
+		}
+		r[nb-1]++;
+	}
+	t=1;
+	for(b=0;b<nb;b++){
+		c[b]=Binomial(bn[b],r[b]);
+		t*=c[b];
+	}
+	pmax=scale;
+	for(n=0;n<K;n++){
+		pmax*=theta[ord[gs[g[n]]]&0xFFFFFFFFULL];
+	}
+	if((t==0)||(pmax<=0)){
+		return;
+	}
+	if(pmax>1){
+		pmax=1;
+	}
+	lq=log1p(-pmax);
+	pos=0;
+	while(1){
+		if(pmax<1){
+			s=floor(log(1-Random())/lq);
+			if(s>=(double)(t-pos)){
+				break;
+			}
+			pos+=(unsigned __int128)s;
+		}
+		/* Nodes of candidate pos */
+		idx=pos;
+		j=0;
+		for(b=0;b<nb;b++){
+			Unrank(idx%c[b],bn[b],r[b],w);
+			idx/=c[b];
+			for(n=0;n<r[b];n++){
+				v[j++]=(int)(ord[bs[b]+w[n]]&0xFFFFFFFFULL);
+			}
+		}
+		p=scale;
+		for(n=0;n<K;n++){
+			p*=theta[v[n]];
+		}
+		if(Random()*pmax<p){
+			Sort(v);
+			if(ncs==mcs){
+				COUNT(ngrow);
+				mcs=2*mcs+1024;
+				cs=(int*)realloc(cs,K*mcs*sizeof(int));
+			}
+			memcpy(cs+K*ncs,v,K*sizeof(int));
+			ncs++;
+		}
+		pos++;
+		if(pos>=t){
+			break;
+		}
+	}
+}
+/*************************************************************************************************/
+/* Generate a simplicial complex of the canonical ensemble with the hidden variables kgi, leaving it
+in the table of the simplices and in the lists of the nodes as the matching would */
+void Canonical(){
+	int i,n,ng,g[K];
+	long long e,gs[MAXGROUP],gn[MAXGROUP];
+	double sum,scale,top;
+
+	/* Hidden variables, and nodes sorted by decreasing hidden variable */
+	sum=0;
+	e=0;
+	for(i=0;i<N;i++){
+		u[i]=kgi[i];
+		sum+=u[i];
+		if(kgi[i]>0){
+			ord[e++]=((unsigned long long)(INT_MAX-kgi[i])<<32)|(unsigned long long)i;
+		}
+	}
+	qsort(ord,e,sizeof(unsigned long long),Compare);
+	if(Binomial(e,K)==BIG){
+		fprintf(stderr,"Too many possible simplices for canonical=1 with D=%d and %lld nodes\n",D,e);
+		exit(1);
+	}
+	scale=1;
+	for(n=1;n<=D;n++){
+		scale=scale*n/sum;
+	}
+	/* Groups in which the hidden variables are within a factor 2 */
+	ng=0;
+	if(e>0){
+		top=u[ord[0]&0xFFFFFFFFULL];
+		gs[0]=0;
+		gn[0]=0;
+		ng=1;
+		for(i=0;i<e;i++){
+			while((u[ord[i]&0xFFFFFFFFULL]*ldexp(1,ng)<=top)&&(ng<MAXGROUP)){
+				gs[ng]=i;
+				gn[ng]=0;
+				ng++;
+			}
+			gn[ng-1]++;
+		}
+	}
+	/* Every choice of K groups, in increasing order */
+	ncs=0;
+	if(ng>0){
+		for(n=0;n<K;n++){
+			g[n]=0;
+		}
+		while(1){
+			Candidates(g,gs,gn,u,scale);
+			for(n=D;(n>=0)&&(g[n]==ng-1);n--);
+			if(n<0){
+				break;
+			}
+			g[n]++;
+			for(i=n+1;i<K;i++){
+				g[i]=g[n];
+			}
+		}
+	}
+	/* Simplices stored as those of a complete matching */
+	for(i=0;i<N;i++){
+		kgi[i]=0;
+		kg[i]=0;
+		k[i]=0;
+	}
+	for(e=0;e<ncs;e++){
+		for(n=0;n<K;n++){
+			kgi[cs[K*e+n]]++;
+		}
+	}
+	Layout();
+	ClearSimplices(ncs);
+	for(e=0;e<ncs;e++){
+		for(n=0;n<K;n++){
+			kg[cs[K*e+n]]++;
+			kgi[cs[K*e+n]]--;
+		}
+		Simplex(cs+K*e);
+	}
+}
@@ -0,0 +1,238 @@
+/**************************************************************************************************
+ * Checkpoints of the matching, taken by SC.h every t seconds when checkpoint=t, in the file name.ckpt
+ * of every replica, and restored when the code is run again with resume=1. A replica resumed from its
+ * checkpoint continues exactly as it would have without the interruption, so that its files are the
+ * same. The checkpoint of a replica is deleted once the replica is printed, so that the replicas
+ * already finished are generated again from their seed.
+ *
+ * Writing the whole state every time would take a time of the order of the number of stubs. Instead
+ * the file is a journal, to which a checkpoint only appends what happened since the previous one: the
+ * simplices created, the stubs lost (Avoid=0) and the simplices removed by the repairs, followed by the
+ * state of the generator. When the matching is restarted the journal starts again from the desired
+ * generalized degrees. It is restored by memory-mapping it and replaying it up to the last complete
+ * state, so that a checkpoint cut short by the interruption is ignored.
+ * Checkpoints are not taken for the canonical ensemble nor when streaming.
+ *
+ * The file is written in the byte order of the machine, every count as a 64-bit integer, and every
+ * array of 32-bit integers followed by zeros up to a multiple of 8 bytes:
+ *     "SCCKPT01", hlen, the line of the parameters of the replica (hlen characters), sbits, the
+ *     desired generalized degrees (N 32-bit integers), then for every checkpoint
+ *     nop, nop operations of K+1 32-bit integers, rs[4], xaus, naus, nrep, nrestart, nrepair, nback, nsim
+ * An operation is 1 (simplex created) or 2 (stubs lost) followed by the K nodes, or 3 (simplex
+ * removed) followed by the high and low 32 bits of its slot in the table.
+ *************************************************************************************************/
+
+#define NSTATE 11  /* 64-bit integers of the state of the generator at a checkpoint */
+
+double checkpoint=0;  /* Seconds between two checkpoints (0 for none) */
+int resume=0;  /* Resume the replicas from their checkpoints */
+
+_Thread_local char ckname[sizeof(file)+64],ckhead[sizeof(degrees)+512];  /* File and line of the replica */
+_Thread_local int journal,jfresh,*jop;  /* Whether checkpoints are taken, and whether the file is to be started again */
+_Thread_local long long njop,mjop,nstep;  /* Operations since the previous checkpoint, and proposals */
+_Thread_local double tcheck;  /* Time of the previous checkpoint */
+
+/*************************************************************************************************/
+/* Number of bytes n rounded up to a multiple of 8 */
+long long Round(long long n){
+	return((n+7)&~7LL);
+}
+/*************************************************************************************************/
+/* Add an operation of the matching to those not yet in the file: 1 simplex v created, 2 stubs v
+lost, 3 simplex in slot s removed */
+static inline void Journal(int op, const int *v, long long s){
+	int *o;
+	if(journal==0){
+		return;
+	}
+	if(njop==mjop){
+		mjop=2*mjop+1024;
+		jop=(int*)realloc(jop,(K+1)*mjop*sizeof(int));
+	}
+	o=jop+(K+1)*njop;
+	o[0]=op;
+	if(op==3){
+		memset(o+1,0,K*sizeof(int));
+		o[1]=(int)(s>>32);
+		o[2]=(int)(s&0xFFFFFFFFLL);
+	}
+	else{
+		memcpy(o+1,v,K*sizeof(int));
+	}
+	njop++;
+}
+/*************************************************************************************************/
+/* Start the journal of a new matching. The file is started again at the next checkpoint */
+void Begin(){
+	njop=0;
+	jfresh=1;
+}
+/*************************************************************************************************/
+/* Write n bytes p to the file fp, followed by zeros up to a multiple of 8 bytes */
+void Write(FILE *fp, const void *p, long long n){
+	static const char zero[8]={0};
+	if((fwrite(p,1,n,fp)!=(size_t)n)||(fwrite(zero,1,Round(n)-n,fp)!=(size_t)(Round(n)-n))){
+		fprintf(stderr,"Cannot write %s\n",ckname);
+		exit(1);
+	}
+}
+/*************************************************************************************************/
+/* Take a checkpoint of the matching, with xaus stubs left, naus back-tracks of the current matching
+and nrep repairs made since it started. A new file is written to name.ckpt.tmp and renamed, so that
+the previous checkpoint is kept until it is complete */
+void Snapshot(double xaus, int naus, int nrep){
+	char tmp[sizeof(ckname)+8];
+	unsigned long long x[NSTATE];
+	int i,*d;
+	FILE *fp;
+
+	snprintf(tmp,sizeof(tmp),"%s.tmp",ckname);
+	fp=fopen((jfresh==1)?tmp:ckname,(jfresh==1)?"wb":"ab");
+	if(fp==NULL){
+		fprintf(stderr,"Cannot open %s\n",(jfresh==1)?tmp:ckname);
+		exit(1);
+	}
+	if(jfresh==1){
+	/* Desired generalized degrees, the stubs already matched and those left */
+		d=(int*)malloc(N*sizeof(int));
+		for(i=0;i<N;i++){
+			d[i]=kgi[i]+kg[i];
+		}
+		x[0]=strlen(ckhead);
+		x[1]=sbits;
+		Write(fp,"SCCKPT01",8);
+		Write(fp,x,8);
+		Write(fp,ckhead,x[0]);
+		Write(fp,x+1,8);
+		Write(fp,d,N*sizeof(int));
+		free(d);
+	}
+	x[0]=njop;
+	Write(fp,x,8);
+	Write(fp,jop,(K+1)*njop*sizeof(int));
+	memcpy(x,rs,sizeof(rs));
+	memcpy(x+4,&xaus,8);
+	x[5]=naus;
+	x[6]=nrep;
+	x[7]=nrestart;
+	x[8]=nrepair;
+	x[9]=nback;
+	x[10]=nsim;
+	Write(fp,x,NSTATE*8);
+	if((fflush(fp)!=0)||(fsync(fileno(fp))!=0)||(fclose(fp)!=0)){
+		fprintf(stderr,"Cannot write %s\n",ckname);
+		exit(1);
+	}
+	if((jfresh==1)&&(rename(tmp,ckname)!=0)){
+		fprintf(stderr,"Cannot rename %s\n",tmp);
+		exit(1);
+	}
+	njop=0;
+	jfresh=0;
+	tcheck=Now();
+}
+/*************************************************************************************************/
+/* Restore the matching of the replica from its checkpoint, if resume=1 and the file holds one with
+the same parameters. Outputs 1 if the matching was restored, with xaus stubs left, naus back-tracks
+of the current matching and nrep repairs made since it started, and 0 otherwise */
+int Restore(double *xaus, int *naus, int *nrep){
+	int fd,b,n,i,*o;
+	long long pos,end,last,hlen,nop,e,s;
+	unsigned long long x[NSTATE];
+	struct stat st;
+	char *p;
+
+	tcheck=Now();
+	Begin();
+	if((resume==0)||(ckname[0]==0)){
+		return(0);
+	}
+	fd=open(ckname,O_RDONLY);
+	if(fd<0){
+		return(0);
+	}
+	if((fstat(fd,&st)!=0)||(st.st_size<16)){
+		close(fd);
+		return(0);
+	}
+	end=st.st_size;
+	p=(char*)mmap(NULL,end,PROT_READ,MAP_PRIVATE,fd,0);
+	close(fd);
+	if(p==MAP_FAILED){
+		return(0);
+	}
+	/* Parameters of the replica, and last complete checkpoint */
+	hlen=*(long long*)(p+8);
+	pos=16+Round(hlen)+8+Round(N*sizeof(int));
+	last=-1;
+	if((memcmp(p,"SCCKPT01",8)==0)&&(hlen==(long long)strlen(ckhead))&&(pos<=end)&&
+		(memcmp(p+16,ckhead,hlen)==0)){
+		for(e=pos;e+8<=end;){
+			nop=*(long long*)(p+e);
+			e+=8+Round((K+1)*nop*sizeof(int))+NSTATE*8;
+			if(e>end){
+				break;
+			}
+			last=e;
+		}
+	}
+	if(last<0){
+		munmap(p,end);
+		return(0);
+	}
+	/* Matching started again from the desired generalized degrees, with the table of the same size */
+	memcpy(kgi,p+pos-Round(N*sizeof(int)),N*sizeof(int));
+	for(i=0;i<N;i++){
+		kg[i]=0;
+		k[i]=0;
+	}
+	Build();
+	Layout();
+	b=(int)*(long long*)(p+pos-Round(N*sizeof(int))-8);
+	if((b!=sbits)||(smapped!=(store[0]!=0))){
+		Table(b);
+	}
+	ClearSimplices(0);
+	/* Operations replayed in order */
+	while(pos<last){
+		nop=*(long long*)(p+pos);
+		o=(int*)(p+pos+8);
+		for(e=0;e<nop;e++,o+=K+1){
+			if(o[0]==3){
+				s=((long long)(unsigned)o[1]<<32)|(unsigned)o[2];
+				Remove(s);
+				continue;
+			}
+			for(n=0;n<K;n++){
+				kg[o[1+n]]++;
+				kgi[o[1+n]]--;
+				Update(o[1+n],-1);
+			}
+			if(o[0]==1){
+				Simplex(o+1);
+			}
+		}
+		pos+=8+Round((K+1)*nop*sizeof(int));
+		memcpy(x,p+pos,NSTATE*8);
+		pos+=NSTATE*8;
+	}
+	munmap(p,end);
+	memcpy(rs,x,sizeof(rs));
+	memcpy(xaus,x+4,8);
+	*naus=(int)x[5];
+	*nrep=(int)x[6];
+	nrestart=x[7];
+	nrepair=x[8];
+	nback=x[9];
+	/* A checkpoint cut short is dropped, so that the next one follows the last complete one */
+	if((long long)x[10]!=nsim){
+		fprintf(stderr,"Cannot restore %s\n",ckname);
+		exit(1);
+	}
+	if(truncate(ckname,last)!=0){
+		fprintf(stderr,"Cannot truncate %s\n",ckname);
+		exit(1);
+	}
+	jfresh=0;
+	return(1);
+}
@@ -0,0 +1,671 @@
+/**************************************************************************************************
+ * Ensembles shared among worker processes, used by SC.h when workers=W or port=P is given. The
+ * process run by the user is then the coordinator: it cuts the replicas of every point of the sweep
+ * into shards of shard=... consecutive replicas, and hands them out to the workers, one at a time, over
+ * TCP connections. workers=W forks W workers on the same machine, which share its threads (threads=...,
+ * by default every core), and port=P also accepts workers started on other machines with
+ *     ./SC_d3 coordinator=host:P threads=...
+ * which run until the ensemble is done. A worker gets the parameters and the seed from the coordinator
+ * (all of them except threads), so the same code compiled for the same machine is all it needs, and it
+ * writes its files itself, relative to the directory where it runs (a shared directory in a cluster).
+ *
+ * Replica r of point p is generated from the stream of the generator with index b+r, where b is the
+ * number of replicas of the points before p, as in a single process: a worker seeds the generator
+ * with the seed of the coordinator and jumps (Jump) to the stream of the first replica of its shard.
+ * The streams of the replicas are thus disjoint whichever worker generates them, and the files are
+ * the same as those of a single process run with the same seed.
+ *
+ * When a worker is done with a shard it sends back the sums of the statistics of its replicas (stats=1)
+ * and the names and sizes of the files it wrote. The coordinator adds the sums of the shards of every
+ * point and prints its .stats file once all of them are back, and writes a line "point replica host
+ * file bytes" for every file in the file name.manifest. When the connection to a worker is lost (the
+ * worker, its machine or the network failed) its shard is handed out again, up to MAXTRY times, and a
+ * local worker that died is started again. A shard is only counted when it is back, so that no replica
+ * is missing or counted twice. With mcmc>0 a shard is a whole chain, whose .mcmc file the worker prints.
+ *
+ * The messages are a header {type, length} followed by the data, in the byte order of the machines.
+ * A worker starts by sending D, the size of a long long and a number telling its byte order, and the
+ * coordinator only hands out shards to the workers with the same ones, and only counts the shards
+ * whose sums have the size they announce.
+ *************************************************************************************************/
+
+#include<poll.h>
+#include<netdb.h>
+#include<sys/wait.h>
+#include<sys/socket.h>
+#include<netinet/in.h>
+#include<arpa/inet.h>
+
+#define MAXLINK 1024  /* Most workers connected at once */
+#define MAXTRY 3  /* Most times a shard is handed out */
+#define ORDER 0x0102030405060708LL  /* Tells the byte order of a machine */
+
+/* Types of the messages */
+enum{HELLO,ARGS,SHARD,DONE,STOP};
+
+/* Replicas first to last-1 of point, whose streams start at index base */
+struct Shard{
+	long point,first,last;
+	long long base;
+	int tries,state;  /* state 0 waiting, 1 handed out, 2 done */
+};
+
+/* Connection to a worker, and the shard it works on (-1 for none) */
+struct Link{
+	int fd,ok;  /* ok is 1 once the worker is known to match the coordinator */
+	long shard;
+	char host[256];
+};
+
+/* Sums of the statistics of a point, and its replicas back */
+struct Tally{
+	long long *skg,*sk;
+	double *sknn,*sC;
+	int nskg,nsk;
+	long nstat,done;
+};
+
+/*************************************************************************************************/
+/* Send a message of type t with the n bytes of data. Outputs 0, or 1 if the connection is lost */
+int Send(int fd, int t, const void *data, long long n){
+	long long h[2]={t,n},x;
+	const char *c;
+	int part;
+	for(part=0;part<2;part++){
+		c=(part==0)?(const char*)h:(const char*)data;
+		n=(part==0)?(long long)sizeof(h):h[1];
+		while(n>0){
+			x=send(fd,c,n,MSG_NOSIGNAL);
+			if(x<=0){
+				return(1);
+			}
+			c+=x;
+			n-=x;
+		}
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Read n bytes. Outputs 0, or 1 if the connection is lost */
+int Read(int fd, void *data, long long n){
+	char *c=(char*)data;
+	long long x;
+	while(n>0){
+		x=recv(fd,c,n,0);
+		if(x<=0){
+			return(1);
+		}
+		c+=x;
+		n-=x;
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Receive a message in *data (enlarged as needed, with a 0 after the data) and its type in *t. Outputs
+its length, or -1 if the connection is lost */
+long long Receive(int fd, int *t, char **data, long long *size){
+	long long h[2];
+	if((Read(fd,h,sizeof(h))==1)||(h[1]<0)){
+		return(-1);
+	}
+	if(h[1]+1>*size){
+		*size=h[1]+1;
+		*data=(char*)realloc(*data,*size);
+		if(*data==NULL){
+			*size=0;
+			return(-1);
+		}
+	}
+	if(Read(fd,*data,h[1])==1){
+		return(-1);
+	}
+	(*data)[h[1]]=0;
+	*t=(int)h[0];
+	return(h[1]);
+}
+/*************************************************************************************************/
+/* Connection to host:port. Outputs -1 if it cannot be made */
+int Dial(const char *host, int p){
+	struct addrinfo hint,*res,*a;
+	char service[16];
+	int fd=-1;
+	memset(&hint,0,sizeof(hint));
+	hint.ai_family=AF_UNSPEC;
+	hint.ai_socktype=SOCK_STREAM;
+	snprintf(service,sizeof(service),"%d",p);
+	if(getaddrinfo(host,service,&hint,&res)!=0){
+		return(-1);
+	}
+	for(a=res;a!=NULL;a=a->ai_next){
+		fd=socket(a->ai_family,a->ai_socktype,a->ai_protocol);
+		if((fd>=0)&&(connect(fd,a->ai_addr,a->ai_addrlen)==0)){
+			break;
+		}
+		if(fd>=0){
+			close(fd);
+		}
+		fd=-1;
+	}
+	freeaddrinfo(res);
+	return(fd);
+}
+/*************************************************************************************************/
+/* Add to the text *list (of capacity *size) the line "r name bytes" of every file of replica r (r>=0)
+or of the current point (r<0) that exists */
+void Files(char **list, long long *size, long r){
+	char name[sizeof(file)+64];
+	const char *ext[5];
+	const char *dot;
+	struct stat st;
+	size_t l;
+	int n,ne=0;
+	dot=Stem(name,sizeof(name),r);
+	l=strlen(name);
+	if(r<0){
+		ext[ne++]=".mcmc";
+	}
+	else{
+		if((facets==1)||(streaming==1)){
+			ext[ne++]=".facets";
+		}
+		if(faces==1){
+			ext[ne++]=".faces";
+		}
+		if(figure==1){
+			ext[ne++]=dot;
+		}
+	}
+	for(n=0;n<ne;n++){
+		snprintf(name+l,sizeof(name)-l,"%s",ext[n]);
+		if(stat(name,&st)==0){
+			while(strlen(*list)+strlen(name)+64>(size_t)*size){
+				*size=2*(*size);
+				*list=(char*)realloc(*list,*size);
+			}
+			snprintf(*list+strlen(*list),*size-strlen(*list),"%ld %s %lld\n",r,name,(long long)st.st_size);
+		}
+	}
+}
+/*************************************************************************************************/
+/* Worker: generate the shards sent by the coordinator on the connection fd, or on a new connection to
+coordinator if fd<0, until it stops */
+void Serve(int fd){
+	char *msg=NULL,*list,*c,host[256];
+	long long size=0,lsize=4096,n,at=-1,h[3],*s;
+	long r;
+	int t,a;
+	char *colon;
+
+	if(fd<0){
+		colon=strrchr(coordinator,':');
+		if(colon==NULL){
+			fprintf(stderr,"Bad coordinator %s, given as host:port\n",coordinator);
+			exit(1);
+		}
+		*colon=0;
+		fd=Dial(coordinator,atoi(colon+1));
+		if(fd<0){
+			fprintf(stderr,"Cannot connect to %s:%s\n",coordinator,colon+1);
+			exit(1);
+		}
+	}
+	if(gethostname(host,sizeof(host))!=0){
+		snprintf(host,sizeof(host),"unknown");
+	}
+	host[sizeof(host)-1]=0;
+	/* D, size of a long long and byte order of the worker, then its name */
+	n=3*sizeof(long long)+strlen(host);
+	msg=(char*)malloc(n);
+	h[0]=D;
+	h[1]=sizeof(long long);
+	h[2]=ORDER;
+	memcpy(msg,h,sizeof(h));
+	memcpy(msg+sizeof(h),host,strlen(host));
+	Send(fd,HELLO,msg,n);
+	size=n;
+	list=(char*)malloc(lsize);
+	point=-1;
+	while((n=Receive(fd,&t,&msg,&size))>=0){
+		if(t==ARGS){
+		/* Parameters of the coordinator, name=value[,value...] separated by 0 */
+			for(a=0;a<npar;a++){
+				free(pname[a]);
+			}
+			npar=0;
+			npoint=1;
+			for(c=msg;c<msg+n;c+=strlen(c)+1){
+				npoint*=Argument(c);
+			}
+			point=-1;
+			at=-1;
+		}
+		else if(t==SHARD){
+			s=(long long*)msg;
+			if(s[0]!=point){
+				point=s[0];
+				Point(point);
+				Distribution(Cutoff());
+			}
+			/* Stream of the first replica of the shard */
+			if((at<0)||(s[3]<at)){
+				Seed(stream,seed);
+				at=0;
+			}
+			for(;at<s[3];at++){
+				Jump(stream);
+			}
+			replica=s[1];
+			rend=s[2];
+			Replicas();
+			at+=s[2]-s[1];
+			if((mcmc>0)&&(streaming==0)&&(store[0]==0)){
+				Summary(".mcmc");
+			}
+			/* Statistics of the shard, then its files */
+			list[0]=0;
+			for(r=s[1];r<s[2];r++){
+				Files(&list,&lsize,r);
+			}
+			if((mcmc>0)&&(streaming==0)&&(store[0]==0)){
+				Files(&list,&lsize,-1);
+			}
+			h[0]=nstat;
+			h[1]=nskg;
+			h[2]=nsk;
+			n=sizeof(h)+nskg*sizeof(long long)+nsk*(sizeof(long long)+2*sizeof(double))+strlen(list);
+			if(n+1>size){
+				size=n+1;
+				msg=(char*)realloc(msg,size);
+			}
+			c=msg;
+			memcpy(c,h,sizeof(h));
+			c+=sizeof(h);
+			memcpy(c,skg,nskg*sizeof(long long));
+			c+=nskg*sizeof(long long);
+			memcpy(c,sk,nsk*sizeof(long long));
+			c+=nsk*sizeof(long long);
+			memcpy(c,sknn,nsk*sizeof(double));
+			c+=nsk*sizeof(double);
+			memcpy(c,sC,nsk*sizeof(double));
+			c+=nsk*sizeof(double);
+			memcpy(c,list,strlen(list));
+			if(Send(fd,DONE,msg,n)==1){
+				break;
+			}
+		}
+		else{
+			break;
+		}
+	}
+	if(n<0){
+		fprintf(stderr,"Connection to the coordinator lost (a worker is compiled with the same D)\n");
+		exit(1);
+	}
+	close(fd);
+	free(msg);
+	free(list);
+}
+/*************************************************************************************************/
+/* Start a local worker connected to the coordinator on port p, with th threads. Outputs its pid */
+pid_t Spawn(int lfd, int p, int th){
+	pid_t pid;
+	int fd;
+	fflush(NULL);  /* Nothing buffered is written again by the worker */
+	pid=fork();
+	if(pid<0){
+		fprintf(stderr,"Cannot start a worker\n");
+		exit(1);
+	}
+	if(pid==0){
+		close(lfd);
+		threads=th;
+		fd=Dial("127.0.0.1",p);
+		if(fd<0){
+			fprintf(stderr,"Cannot connect to the coordinator\n");
+			exit(1);
+		}
+		Serve(fd);
+		exit(0);
+	}
+	return(pid);
+}
+/*************************************************************************************************/
+/* Offset of the list of the files in the message data of n bytes with the sums of a shard, or -1 if
+the message is shorter than the sums it announces */
+long long Sums(const char *data, long long n){
+	long long h[3],x,y;
+	if(n<(long long)sizeof(h)){
+		return(-1);
+	}
+	memcpy(h,data,sizeof(h));
+	/* skg, then sk, sknn and sC */
+	x=sizeof(long long);
+	y=sizeof(long long)+2*sizeof(double);
+	if((h[0]<0)||(h[1]<0)||(h[2]<0)||(h[1]>INT_MAX)||(h[2]>INT_MAX)||(h[1]>n/x)||(h[2]>n/y)||
+		((long long)sizeof(h)+x*h[1]+y*h[2]>n)){
+		return(-1);
+	}
+	return(sizeof(h)+x*h[1]+y*h[2]);
+}
+/*************************************************************************************************/
+/* Add the sums of the statistics of a shard, sent in data and checked by Sums, to the tally ta */
+void Add(struct Tally *ta, const char *data){
+	long long h[3];
+	const char *c=data+sizeof(h);
+	int i,t;
+	memcpy(h,data,sizeof(h));
+	if(h[1]>ta->nskg){
+		t=ta->nskg;
+		ta->nskg=(int)h[1];
+		ta->skg=(long long*)realloc(ta->skg,ta->nskg*sizeof(long long));
+		memset(ta->skg+t,0,(ta->nskg-t)*sizeof(long long));
+	}
+	if(h[2]>ta->nsk){
+		t=ta->nsk;
+		ta->nsk=(int)h[2];
+		ta->sk=(long long*)realloc(ta->sk,ta->nsk*sizeof(long long));
+		ta->sknn=(double*)realloc(ta->sknn,ta->nsk*sizeof(double));
+		ta->sC=(double*)realloc(ta->sC,ta->nsk*sizeof(double));
+		memset(ta->sk+t,0,(ta->nsk-t)*sizeof(long long));
+		memset(ta->sknn+t,0,(ta->nsk-t)*sizeof(double));
+		memset(ta->sC+t,0,(ta->nsk-t)*sizeof(double));
+	}
+	for(i=0;i<h[1];i++,c+=sizeof(long long)){
+		ta->skg[i]+=((const long long*)c)[0];
+	}
+	for(i=0;i<h[2];i++,c+=sizeof(long long)){
+		ta->sk[i]+=((const long long*)c)[0];
+	}
+	for(i=0;i<h[2];i++,c+=sizeof(double)){
+		ta->sknn[i]+=((const double*)c)[0];
+	}
+	for(i=0;i<h[2];i++,c+=sizeof(double)){
+		ta->sC[i]+=((const double*)c)[0];
+	}
+	ta->nstat+=h[0];
+}
+/*************************************************************************************************/
+/* Print the statistics of point p from its tally, and free it */
+void Tallied(long p, struct Tally *ta, FILE *mp, const char *host){
+	char name[sizeof(file)+64];
+	struct stat st;
+	point=p;
+	Point(p);
+	if(stats==1){
+		skg=ta->skg;
+		sk=ta->sk;
+		sknn=ta->sknn;
+		sC=ta->sC;
+		nskg=ta->nskg;
+		nsk=ta->nsk;
+		nstat=ta->nstat;
+		Summary(".stats");
+		Stem(name,sizeof(name),-1);
+		snprintf(name+strlen(name),sizeof(name)-strlen(name),".stats");
+		if(stat(name,&st)==0){
+			fprintf(mp,"%ld -1 %s %s %lld\n",p,host,name,(long long)st.st_size);
+		}
+		skg=sk=NULL;
+		sknn=sC=NULL;
+		nskg=nsk=0;
+	}
+	free(ta->skg);
+	free(ta->sk);
+	free(ta->sknn);
+	free(ta->sC);
+	if((npoint>1)&&(bench==0)){
+		fprintf((strcmp(file,"-")==0)?stderr:stdout,"%ld N=%d m=%d gamma2=%g Avoid=%d NX=%d\n",p,N,m,gamma2,Avoid,NX);
+		fflush(stdout);
+	}
+}
+/*************************************************************************************************/
+/* Coordinator: hand out the shards of the ensemble to the workers, collect their statistics and the
+list of their files, and hand out again the shards of the workers lost */
+void Coordinate(){
+	struct Shard *sh;
+	struct Tally *ta;
+	struct Link ln[MAXLINK];
+	struct pollfd pf[MAXLINK+1];
+	struct sockaddr_in addr;
+	socklen_t alen;
+	pid_t *pid;
+	FILE *mp;
+	char *msg=NULL,*args,*c,*e,name[sizeof(file)+64],host[256];
+	const char *dot;
+	long long size=0,base=0,n,na,m4[4];
+	long ns=0,done=0,next=0,s,p,r,len,retries=0,spawns=0;
+	int lfd,p0,nl=0,l,t,a,w,th,one=1,ready;
+
+	if((streaming==1)&&(strcmp(file,"-")==0)){
+		fprintf(stderr,"The workers cannot stream to the standard output (file=-)\n");
+		exit(1);
+	}
+	/* Shards of every point, with the index of the stream of their first replica */
+	sh=NULL;
+	for(p=0;p<npoint;p++){
+		Point(p);
+		point=p;
+		Valid();
+		/* By default about 4 shards per worker, and a chain in a single shard */
+		len=(shard>0)?shard:R/(4*((workers>0)?workers:4));
+		if(mcmc>0){
+			len=R;
+		}
+		if(len<1){
+			len=1;
+		}
+		for(r=0;r<R;r+=len){
+			sh=(struct Shard*)realloc(sh,(ns+1)*sizeof(struct Shard));
+			sh[ns].point=p;
+			sh[ns].first=r;
+			sh[ns].last=(r+len<R)?r+len:R;
+			sh[ns].base=base+r;
+			sh[ns].tries=0;
+			sh[ns].state=0;
+			ns++;
+		}
+		base+=R;
+	}
+	ta=(struct Tally*)calloc(npoint,sizeof(struct Tally));
+
+	/* Parameters sent to the workers, except those of the coordinator and threads, and the seed */
+	len=64;
+	for(a=0;a<npar;a++){
+		len+=strlen(pname[a])+strlen(pval[a])+2;
+	}
+	args=(char*)malloc(len);
+	c=args;
+	for(a=0;a<npar;a++){
+		if((strcmp(pname[a],"workers")!=0)&&(strcmp(pname[a],"port")!=0)&&(strcmp(pname[a],"shard")!=0)&&
+			(strcmp(pname[a],"coordinator")!=0)&&(strcmp(pname[a],"threads")!=0)&&(strcmp(pname[a],"seed")!=0)){
+			c+=sprintf(c,"%s=%s",pname[a],pval[a])+1;
+		}
+	}
+	c+=sprintf(c,"seed=%llu",seed)+1;
+	na=c-args;
+
+	/* Port of the coordinator, open to other machines with port=P and otherwise only to this one */
+	lfd=socket(AF_INET,SOCK_STREAM,0);
+	setsockopt(lfd,SOL_SOCKET,SO_REUSEADDR,&one,sizeof(one));
+	memset(&addr,0,sizeof(addr));
+	addr.sin_family=AF_INET;
+	addr.sin_addr.s_addr=htonl((port>0)?INADDR_ANY:INADDR_LOOPBACK);
+	addr.sin_port=htons(port);
+	alen=sizeof(addr);
+	if((lfd<0)||(bind(lfd,(struct sockaddr*)&addr,sizeof(addr))!=0)||(listen(lfd,64)!=0)||
+		(getsockname(lfd,(struct sockaddr*)&addr,&alen)!=0)){
+		fprintf(stderr,"Cannot listen on port %d\n",port);
+		exit(1);
+	}
+	p0=ntohs(addr.sin_port);
+	if(port>0){
+		fprintf(stderr,"Coordinator listening on port %d\n",p0);
+	}
+	if(gethostname(host,sizeof(host))!=0){
+		snprintf(host,sizeof(host),"unknown");
+	}
+	host[sizeof(host)-1]=0;
+
+	/* List of the files, named after file */
+	dot=strrchr(file,'.');
+	if((dot==NULL)||(strchr(dot,'/')!=NULL)){
+		dot=file+strlen(file);
+	}
+	snprintf(name,sizeof(name),"%.*s.manifest",(int)(dot-file),file);
+	mp=fopen(name,"w");
+	if(mp==NULL){
+		fprintf(stderr,"Cannot open %s\n",name);
+		exit(1);
+	}
+	fprintf(mp,"# point replica host file bytes\n");
+
+	/* Local workers, sharing the threads */
+	th=(workers>0)?threads/workers:1;
+	if(th<1){
+		th=1;
+	}
+	pid=(pid_t*)malloc((workers+1)*sizeof(pid_t));
+	for(w=0;w<workers;w++){
+		pid[w]=Spawn(lfd,p0,th);
+	}
+
+	while(done<ns){
+		pf[0].fd=lfd;
+		pf[0].events=POLLIN;
+		for(l=0;l<nl;l++){
+			pf[l+1].fd=ln[l].fd;
+			pf[l+1].events=POLLIN;
+		}
+		ready=poll(pf,nl+1,1000);
+		if(ready<0){
+			continue;
+		}
+		/* Local workers that died are started again, a limited number of times */
+		for(w=0;w<workers;w++){
+			if((pid[w]>0)&&(waitpid(pid[w],NULL,WNOHANG)==pid[w])){
+				pid[w]=0;
+				if(spawns<MAXTRY*workers){
+					spawns++;
+					pid[w]=Spawn(lfd,p0,th);
+				}
+			}
+		}
+		for(l=0;l<nl;l++){
+			if(pf[l+1].revents==0){
+				continue;
+			}
+			n=Receive(ln[l].fd,&t,&msg,&size);
+			m4[0]=m4[1]=-1;
+			if(n>=3*(long long)sizeof(long long)){
+				memcpy(m4,msg,3*sizeof(long long));
+			}
+			if((n>=3*(long long)sizeof(long long))&&(t==HELLO)&&(ln[l].ok==0)&&(m4[0]==D)&&
+				(m4[1]==sizeof(long long))&&(m4[2]==ORDER)){
+				snprintf(ln[l].host,sizeof(ln[l].host),"%s",msg+3*sizeof(long long));
+				ln[l].ok=1;
+			}
+			else if((t==DONE)&&(ln[l].shard>=0)&&(Sums(msg,n)>=0)){
+				s=ln[l].shard;
+				p=sh[s].point;
+				sh[s].state=2;
+				ln[l].shard=-1;
+				done++;
+				Add(&ta[p],msg);
+				/* Files of the shard, a line "r name bytes" each, after the sums */
+				e=msg+Sums(msg,n);
+				while((c=strchr(e,'\n'))!=NULL){
+					*c=0;
+					r=strtol(e,&e,10);
+					fprintf(mp,"%ld %ld %s%s\n",p,r,ln[l].host,e);
+					e=c+1;
+				}
+				fflush(mp);
+				ta[p].done+=sh[s].last-sh[s].first;
+				Point(p);
+				if(ta[p].done==R){
+					Tallied(p,&ta[p],mp,host);
+				}
+			}
+			else{
+			/* Worker lost or not matching the coordinator, its shard is handed out again */
+				if((n>=0)&&(t==HELLO)){
+					fprintf(stderr,"Worker refused, with D=%lld, long long of %lld bytes or another byte order\n",
+						m4[0],m4[1]);
+				}
+				s=ln[l].shard;
+				if(s>=0){
+					sh[s].state=0;
+					retries++;
+					if(sh[s].tries>=MAXTRY){
+						fprintf(stderr,"Replicas %ld to %ld of point %ld failed %d times\n",sh[s].first,
+							sh[s].last-1,sh[s].point,MAXTRY);
+						exit(1);
+					}
+					if(s<next){
+						next=s;
+					}
+				}
+				close(ln[l].fd);
+				nl--;
+				ln[l]=ln[nl];
+				pf[l+1]=pf[nl+1];
+				l--;
+			}
+		}
+		if((pf[0].revents&POLLIN)&&(nl<MAXLINK)){
+			ln[nl].fd=accept(lfd,NULL,NULL);
+			if(ln[nl].fd>=0){
+				setsockopt(ln[nl].fd,SOL_SOCKET,SO_KEEPALIVE,&one,sizeof(one));
+				ln[nl].shard=-1;
+				ln[nl].ok=0;
+				snprintf(ln[nl].host,sizeof(ln[nl].host),"unknown");
+				Send(ln[nl].fd,ARGS,args,na);
+				nl++;
+			}
+		}
+		/* Next shards handed out to the idle workers */
+		for(l=0;l<nl;l++){
+			if((ln[l].shard>=0)||(ln[l].ok==0)){
+				continue;
+			}
+			while((next<ns)&&(sh[next].state!=0)){
+				next++;
+			}
+			if(next==ns){
+				break;
+			}
+			m4[0]=sh[next].point;
+			m4[1]=sh[next].first;
+			m4[2]=sh[next].last;
+			m4[3]=sh[next].base;
+			if(Send(ln[l].fd,SHARD,m4,sizeof(m4))==0){
+				ln[l].shard=next;
+				sh[next].state=1;
+				sh[next].tries++;
+			}
+		}
+		/* Nobody left to generate the shards */
+		for(w=0;(w<workers)&&(pid[w]==0);w++);
+		if((port==0)&&(nl==0)&&(w==workers)){
+			fprintf(stderr,"The workers failed\n");
+			exit(1);
+		}
+	}
+	fprintf(mp,"# shards=%ld retries=%ld workers=%d\n",ns,retries,workers);
+	fclose(mp);
+	for(l=0;l<nl;l++){
+		Send(ln[l].fd,STOP,NULL,0);
+		close(ln[l].fd);
+	}
+	for(w=0;w<workers;w++){
+		if(pid[w]>0){
+			waitpid(pid[w],NULL,0);
+		}
+	}
+	close(lfd);
+	free(pid);
+	free(args);
+	free(msg);
+	free(ta);
+	free(sh);
+}
@@ -0,0 +1,39 @@
+/**************************************************************************************************
+ * If you use this code, please cite G. Bianconi and O.T. Courtney
+ * "Generalized network structures: the configuration model and the canonical ensemble of
+ * simplicial complexes"
+ * Phys. Rev. E 93, 062311 (2016)
+***************************************************************************************************
+ * Code that  generates random simplicial complexes of dimension 5 with scale-free generalized degree
+ * distribution.
+ *
+ * The option to use a Poisson distributed generalized degree distribution has also been included,
+ * with degrees=poisson (see SC_degrees.h).
+ *
+ * This code uses:
+ * D  Dimension of the simplices
+ * N  Number of nodes in the simplicial complex
+ * m  The minimum of the scale-free distribution
+ * gamma2  Exponent of the scale-free distribution
+ * lambda  Expected value of the Poisson distribution (used with degrees=poisson)
+ * Avoid  Whether or not 'back-tracking' is allowed when illegal matchings are proposed
+ * (Avoid==1 allowed, Avoid==0 not allowed)
+ * NX  Maximum number of 'back-tracks' before matching process restarts from an unmatched network
+ * figure  Whether or not the list of edges is printed (figure==1 printed, figure==0 not printed)
+ *
+ * The generator itself is in SC.h, which is shared by the codes of every dimension.
+ * N, m, gamma2, lambda, Avoid, NX and figure are default values, which can be changed when running the
+ * code, for instance ./SC_d5 N=1000 gamma2=2.5 (see SC.h).
+ *************************************************************************************************/
+
+#define D 5
+
+int N=1000;
+int m=1;
+double gamma2=2.8;
+double lambda=10;
+int Avoid=1;
+int NX=80;
+int figure=1;
+
+#include "SC.h"
@@ -0,0 +1,118 @@
+/**************************************************************************************************
+ * Desired generalized degrees of the nodes, drawn for all the nodes in one pass from the distribution
+ * set by the parameter degrees:
+ *
+ * degrees=scalefree  Scale-free distribution with minimum m and exponent gamma2 (default)
+ * degrees=poisson  Poisson distribution with expected value lambda
+ * degrees=name  Distribution read from the file name, with one line "k P(k)" for each value k of the
+ *               generalized degree (the weights P(k) need not be normalized, lines starting with #
+ *               are ignored)
+ *
+ * Each distribution is truncated at the natural cut-off, so that no generalized degree has to be
+ * re-drawn. The scale-free distribution is sampled by inverting its truncated cumulative distribution,
+ * in a loop that the compiler can vectorize. The other distributions are tabulated once for each
+ * point of a sweep and sampled with a guide table (H.C. Chen and Y. Asau, J. Chin. Inst. Eng. 16,
+ * 256 (1974)), in a constant number of steps per node on average.
+ *************************************************************************************************/
+
+extern double lambda;
+
+char degrees[1024]="scalefree";
+
+/* Tabulated distribution of the current point, shared by the threads: value dk[g] and cumulative
+probability dc[g] of entry g, and guide table of the first entry g with dc[g] larger than j/ndist */
+int ndist,*dk,*guide;
+double *dc;
+
+/*************************************************************************************************/
+/* Add value k with weight w to the table */
+void Tabulate(int k, double w){
+	dk=(int*)realloc(dk,(ndist+1)*sizeof(int));
+	dc=(double*)realloc(dc,(ndist+1)*sizeof(double));
+	dk[ndist]=k;
+	dc[ndist]=w;
+	ndist++;
+}
+/*************************************************************************************************/
+/* Tabulate the distribution of the current point, truncated at the cut-off cut. Nothing is tabulated
+for the scale-free distribution */
+void Distribution(double cut){
+	int k,kmax,j,g;
+	double w,k0,p;
+	char line[4096];
+	FILE *fp;
+	ndist=0;
+	if(strcmp(degrees,"scalefree")==0){
+		return;
+	}
+	if(strcmp(degrees,"poisson")==0){
+	/* Probabilities beyond lambda+20*sqrt(lambda)+20 are smaller than 1e-40 and are left out */
+		kmax=(int)fmin(cut,lambda+20*sqrt(lambda)+20);
+		for(k=0;k<=kmax;k++){
+			Tabulate(k,exp(k*log(lambda)-lambda-lgamma(k+1.)));
+		}
+	}
+	else{
+		fp=fopen(degrees,"r");
+		if(fp==NULL){
+			fprintf(stderr,"Cannot open %s\n",degrees);
+			exit(1);
+		}
+		while(fgets(line,sizeof(line),fp)!=NULL){
+			if((line[0]!='#')&&(sscanf(line,"%lf %lf",&k0,&p)==2)&&(k0>=0)&&(k0<=cut)&&(p>0)){
+				Tabulate((int)k0,p);
+			}
+		}
+		fclose(fp);
+	}
+	w=0;
+	for(g=0;g<ndist;g++){
+		w+=dc[g];
+		dc[g]=w;
+	}
+	if((ndist==0)||(w<=0)){
+		fprintf(stderr,"No generalized degree between 0 and the cut-off %g in degrees=%s\n",cut,degrees);
+		exit(1);
+	}
+	for(g=0;g<ndist;g++){
+		dc[g]/=w;
+	}
+	dc[ndist-1]=1;
+	guide=(int*)realloc(guide,ndist*sizeof(int));
+	g=0;
+	for(j=0;j<ndist;j++){
+		while(dc[g]<=(double)j/ndist){
+			g++;
+		}
+		guide[j]=g;
+	}
+}
+/*************************************************************************************************/
+/* Draw the desired generalized degrees kgi of the N nodes, with values up to the cut-off cut. The
+random numbers are drawn in one batch into u */
+void Degrees(double cut){
+	int i,g;
+	double ex,u0;
+	Randoms(u,N);
+	if(ndist==0){
+	/* Scale-free: y=m*U^(-1/(gamma2-1)) with U uniform in (u0,1], where u0 is the probability that y
+	exceeds cut+1. Drawing y and re-drawing it while it exceeds the cut-off gives the same distribution */
+		ex=-1./(gamma2-1.);
+		u0=pow((cut+1)/m,1-gamma2);
+		for(i=0;i<N;i++){
+			u[i]=m*pow(1-(1-u0)*u[i],ex);
+		}
+		for(i=0;i<N;i++){
+			kgi[i]=(u[i]<cut+1)?(int)u[i]:(int)cut;
+		}
+	}
+	else{
+		for(i=0;i<N;i++){
+			g=guide[(int)(u[i]*ndist)];
+			while(dc[g]<=u[i]){
+				g++;
+			}
+			kgi[i]=dk[g];
+		}
+	}
+}
@@ -0,0 +1,188 @@
+/**************************************************************************************************
+ * Printing of the simplices themselves, used by SC.h when facets=1 or faces=1.
+ *
+ * facets=1 prints the list of the simplices (facets) of the complex in the file name.facets, one per
+ * line with its D+1 nodes in increasing order. The index of a facet is its position in the list.
+ *
+ * faces=1 prints, in the file name.faces, the faces of the facets of every dimension q from 1 to
+ * D-1, each face once with its q+1 nodes in increasing order, sorted, so that the index of a face is
+ * its position in the list of its dimension. For every dimension it also prints the incidence of the
+ * facets and the faces in CSR form: the faces of facet f are idx[ptr[f]] to idx[ptr[f+1]-1], in the
+ * order of the subsets of the nodes of the facet given by the bits of the numbers 0 to 2^(D+1)-1.
+ *
+ * As text the files start with the line starting with # of the list of edges, and in faces each
+ * dimension starts with the lines "# faces q nface" and "# incidence q".
+ * With binary=1 the files are written in a binary layout that can be memory-mapped, in which every
+ * count and offset is a 64-bit integer and every node and index a 32-bit integer, in the byte order
+ * of the machine that wrote the file. The text line and every array of 32-bit integers are followed by
+ * zeros up to a multiple of 8 bytes, so that every 64-bit integer is aligned:
+ *
+ * facets  "SCFACET1", hlen, the text line (hlen characters), D, N, nfacet, the nodes of the facets
+ * faces  "SCFACES1", hlen, the text line (hlen characters), D, N, nfacet, then for every q:
+ *        q, nface, the nodes of the faces, ptr (nfacet+1 offsets), idx (ptr[nfacet] indices)
+ *************************************************************************************************/
+
+_Thread_local int fw;  /* Number of nodes of the faces being sorted */
+
+/*************************************************************************************************/
+/* Order of two faces of fw nodes */
+int FaceCompare(const void *x, const void *y){
+	const int *a=(const int*)x,*b=(const int*)y;
+	int n;
+	for(n=0;n<fw;n++){
+		if(a[n]!=b[n]){
+			return((a[n]>b[n])-(a[n]<b[n]));
+		}
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Start a file of the simplices with the text line head, as text or with its binary header */
+void Head(const char *name, const char *magic, const char *head, long long nf){
+	unsigned long long x;
+	Open(name);
+	if(binary==0){
+		Put(head,strlen(head));
+		return;
+	}
+	Put(magic,8);
+	x=strlen(head);
+	Put(&x,8);
+	Put(head,x);
+	Pad();
+	x=D;
+	Put(&x,8);
+	x=N;
+	Put(&x,8);
+	x=nf;
+	Put(&x,8);
+}
+/*************************************************************************************************/
+/* Add n nodes or indices v, as 32-bit integers or as a line of text */
+void PutNodes(const int *v, int n){
+	int l;
+	if(binary==1){
+		Put(v,n*sizeof(int));
+		return;
+	}
+	for(l=0;l<n;l++){
+		PutInt(v[l],(l==n-1)?'\n':' ');
+	}
+}
+/*************************************************************************************************/
+/* Print the list of facets to file name, streamed from the table of the simplices */
+void PrintFacets(const char *name, const char *head){
+	long long s;
+	int n,v[K];
+	Head(name,"SCFACET1",head,nsim);
+	for(s=0;s<=msim;s++){
+		if(sim[K*s]!=0){
+			for(n=0;n<K;n++){
+				v[n]=sim[K*s+n]-1;
+			}
+			PutNodes(v,K);
+		}
+	}
+	Close();
+}
+/*************************************************************************************************/
+/* Print the faces of every dimension and their incidence with the facets to file name */
+void PrintFaces(const char *name, const char *head){
+	int q,n,l,c,mask,*f,*face,*idx,*t,v[K];
+	long long s,nf,e,a,nface;
+	unsigned long long x;
+	char line[64];
+
+	/* Facets, in the order of the table */
+	f=(int*)malloc((K*nsim+1)*sizeof(int));
+	nf=0;
+	for(s=0;s<=msim;s++){
+		if(sim[K*s]!=0){
+			for(n=0;n<K;n++){
+				f[K*nf+n]=sim[K*s+n]-1;
+			}
+			nf++;
+		}
+	}
+	Head(name,"SCFACES1",head,nf);
+	for(q=1;q<D;q++){
+		fw=q+1;
+		c=0;
+		for(mask=0;mask<(1<<K);mask++){
+			for(l=0,n=0;n<K;n++){
+				l+=(mask>>n)&1;
+			}
+			c+=(l==fw);
+		}
+		/* Faces of all the facets, sorted and made unique */
+		face=(int*)malloc((nf*c*fw+1)*sizeof(int));
+		idx=(int*)malloc((nf*c+1)*sizeof(int));
+		a=0;
+		for(e=0;e<nf;e++){
+			for(mask=0;mask<(1<<K);mask++){
+				for(l=0,n=0;n<K;n++){
+					if((mask>>n)&1){
+						v[l++]=f[K*e+n];
+					}
+				}
+				if(l==fw){
+					memcpy(face+fw*a,v,fw*sizeof(int));
+					a++;
+				}
+			}
+		}
+		qsort(face,a,fw*sizeof(int),FaceCompare);
+		nface=0;
+		for(e=0;e<a;e++){
+			if((nface==0)||(FaceCompare(face+fw*(nface-1),face+fw*e)!=0)){
+				memmove(face+fw*nface,face+fw*e,fw*sizeof(int));
+				nface++;
+			}
+		}
+		/* Index of each face of each facet */
+		a=0;
+		for(e=0;e<nf;e++){
+			for(mask=0;mask<(1<<K);mask++){
+				for(l=0,n=0;n<K;n++){
+					if((mask>>n)&1){
+						v[l++]=f[K*e+n];
+					}
+				}
+				if(l==fw){
+					t=(int*)bsearch(v,face,nface,fw*sizeof(int),FaceCompare);
+					idx[a++]=(int)((t-face)/fw);
+				}
+			}
+		}
+		if(binary==1){
+			x=q;
+			Put(&x,8);
+			x=nface;
+			Put(&x,8);
+			Put(face,nface*fw*sizeof(int));
+			Pad();
+			for(e=0;e<=nf;e++){
+				x=e*c;
+				Put(&x,8);
+			}
+			Put(idx,a*sizeof(int));
+			Pad();
+		}
+		else{
+			snprintf(line,sizeof(line),"# faces %d %lld\n",q,nface);
+			Put(line,strlen(line));
+			for(e=0;e<nface;e++){
+				PutNodes(face+fw*e,fw);
+			}
+			snprintf(line,sizeof(line),"# incidence %d\n",q);
+			Put(line,strlen(line));
+			for(e=0;e<nf;e++){
+				PutNodes(idx+c*e,c);
+			}
+		}
+		free(face);
+		free(idx);
+	}
+	Close();
+	free(f);
+}
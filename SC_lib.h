@@ -0,0 +1,132 @@
+/**************************************************************************************************
+ * Library interface of the generator, compiled instead of main when SC.h is compiled with -DLIBRARY,
+ * for instance as a shared library of dimension 3:
+ *     gcc -O2 -fPIC -shared -fvisibility=hidden -DLIBRARY -pthread -o libSC_d3.so SC_d3.c -lm
+ * A program using it includes this file (without defining D), which then only declares:
+ *
+ * SCGenerate(c, params, seed)  Generate a simplicial complex in c, with the parameters params given
+ *     as in the command line of the codes ("N=1000 gamma2=2.5", separated by blanks, with a single
+ *     value each) and the seed seed. The complex is that of replica 0 of the codes run with the same
+ *     parameters and seed=seed. Outputs 0, or 1 if a parameter is unknown or has a bad value.
+ * SCFree(c)  Free the arrays of c.
+ *
+ * The complex is given in arrays of the caller, in struct SCComplex: the links as compressed sparse
+ * rows (the neighbours of node i are eadj[eoff[i]] to eadj[eoff[i+1]-1], in increasing order), the
+ * facets as size=D+1 nodes each in increasing order, in the order of the table of the simplices, and
+ * the generalized degree kg and degree k of every node. An array is only enlarged with realloc when
+ * its capacity (mnode, madj, mfacet, in elements) is too small, so that it can be allocated by the
+ * caller with malloc, or left NULL with capacity 0, and reused for every complex: once the arrays are
+ * large enough, nothing is allocated, copied to a file or parsed between the generation of a complex
+ * and its analysis. The caller frees them with SCFree or free.
+ *
+ * The parameters keep their values from one call to the next, starting from those set in SC_dX.c, so
+ * that params can be NULL to generate another complex with the same parameters. They are shared by
+ * the threads, and SCGenerate is not to be called by several threads at once; with parallel=1 the
+ * matching of a complex is shared among threads=... threads. The parameters of the output (figure,
+ * R, file, ...) and mcmc are ignored, and streaming=1 is a bad value.
+ *************************************************************************************************/
+
+#ifndef SCCOMPLEX
+#define SCCOMPLEX
+
+struct SCComplex{
+	int N,size;  /* Number of nodes, and of nodes of a facet (D+1) */
+	long long nedge,nfacet;  /* Number of links and facets */
+	long long *eoff;  /* N+1 offsets of the lists of neighbours */
+	int *eadj;  /* 2*nedge neighbours */
+	int *facet;  /* size*nfacet nodes of the facets */
+	int *kg,*k;  /* N generalized degrees and degrees */
+	long long restarts,repairs;  /* Restarts and repairs of the matching */
+	long long mnode,madj,mfacet;  /* Capacities of kg and k (eoff has one more), eadj and facet */
+};
+
+int SCGenerate(struct SCComplex *c, const char *params, unsigned long long seed);
+void SCFree(struct SCComplex *c);
+
+#endif
+
+#ifdef D
+
+#define API __attribute__((visibility("default")))
+
+/*************************************************************************************************/
+/* Generate a simplicial complex with the parameters params and the seed seed, in the arrays of c */
+API int SCGenerate(struct SCComplex *c, const char *params, unsigned long long seed){
+	char buf[4096],*arg,*eq,*save;
+	long long s,f;
+	int n;
+
+	if(params!=NULL){
+		snprintf(buf,sizeof(buf),"%s",params);
+		for(arg=strtok_r(buf," \t\n",&save);arg!=NULL;arg=strtok_r(NULL," \t\n",&save)){
+			eq=strchr(arg,'=');
+			if(eq==NULL){
+				return(1);
+			}
+			*eq=0;
+			if(Set(arg,eq+1)==1){
+				return(1);
+			}
+		}
+	}
+	if((N<=K)||(m<1)||(gamma2<=1)||(lambda<=0)||(NX<0)||(streaming!=0)){
+		return(1);
+	}
+	Distribution(Cutoff());
+	Seed(rs,seed);
+	Allocate();
+	ckname[0]=0;
+	journal=0;
+	inner=(threads>0)?threads:1;
+	Generate();
+	if((figure==0)&&(stats==0)){
+		Edges();
+	}
+
+	/* Arrays of the caller enlarged if needed, then filled */
+	if(N>c->mnode){
+		c->kg=(int*)realloc(c->kg,N*sizeof(int));
+		c->k=(int*)realloc(c->k,N*sizeof(int));
+		c->eoff=(long long*)realloc(c->eoff,(N+1)*sizeof(long long));
+		c->mnode=N;
+	}
+	if(2*nedge>c->madj){
+		c->madj=2*nedge;
+		c->eadj=(int*)realloc(c->eadj,c->madj*sizeof(int));
+	}
+	if(K*nsim>c->mfacet){
+		c->mfacet=K*nsim;
+		c->facet=(int*)realloc(c->facet,c->mfacet*sizeof(int));
+	}
+	c->N=N;
+	c->size=K;
+	c->nedge=nedge;
+	c->nfacet=nsim;
+	c->restarts=nrestart;
+	c->repairs=nrepair;
+	memcpy(c->kg,kg,N*sizeof(int));
+	memcpy(c->k,k,N*sizeof(int));
+	Adjacency(c->eoff,c->eadj);
+	f=0;
+	for(s=0;s<=msim;s++){
+		if(sim[K*s]!=0){
+			for(n=0;n<K;n++){
+				c->facet[K*f+n]=sim[K*s+n]-1;
+			}
+			f++;
+		}
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Free the arrays of c, which can then be used again */
+API void SCFree(struct SCComplex *c){
+	free(c->eoff);
+	free(c->eadj);
+	free(c->facet);
+	free(c->kg);
+	free(c->k);
+	memset(c,0,sizeof(*c));
+}
+
+#endif
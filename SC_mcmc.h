@@ -0,0 +1,175 @@
+/**************************************************************************************************
+ * Markov chain of simplicial complexes, used by SC.h when mcmc=S. The first replica of every point is
+ * generated by the matching, and every next replica by S swaps from the previous one, so that the R
+ * replicas of the point are the samples of a chain that costs a single matching. The replicas of a
+ * chain are generated one after the other by one thread.
+ *
+ * A swap picks two simplices and one node of each at random and exchanges the two nodes, unless a
+ * simplex would then have two equal nodes or already exist (the checks of the matching, made with the
+ * table of the simplices). Every node keeps its generalized degree, and as the swap that undoes a swap
+ * is proposed with the same probability, the chain samples uniformly the simplicial complexes with the
+ * generalized degrees of the first replica (among those it can reach). Each swap takes O(1) steps, and
+ * the lists of the nodes are built again once per sample. A complex with fewer than two simplices is
+ * left as it is, and the restarts, back-tracks and repairs printed for a sample after the first are 0.
+ *
+ * To tell how correlated the samples are, the file name.mcmc gives for every replica the fraction of
+ * the swaps accepted, the fraction of the simplices of the first replica still present (which decays
+ * to about 0 as the chain forgets it) and the number of links, followed by the autocorrelation of the
+ * number of links at lag 1, 2, ... and its integrated autocorrelation time tau=1+2 sum rho (in
+ * samples), the sum of the autocorrelations rho stopping at the first one that is not positive, so that
+ * tau is at least 1. Samples more than 2 tau apart are nearly independent.
+ *************************************************************************************************/
+
+long long mcmc=0;  /* Swaps between two samples (0 for none) */
+
+_Thread_local int *first;  /* Simplices of the first replica of the chain */
+_Thread_local long long nfirst,mfirst;
+
+/* Diagnostics of the samples of the current point */
+double *cacc,*cover,*clink;
+long nchain,mchain;
+
+/*************************************************************************************************/
+/* Propose to exchange a node between two random simplices. Outputs 1 if the swap was made */
+int Swap(){
+	int n,a,b,f[K],g[K],u[K],w[K];
+	long long s,t;
+	do{
+		s=(long long)(Random()*(msim+1));
+	}while(sim[K*s]==0);
+	do{
+		t=(long long)(Random()*(msim+1));
+	}while(sim[K*t]==0);
+	memcpy(f,sim+K*s,K*sizeof(int));
+	memcpy(g,sim+K*t,K*sizeof(int));
+	a=(int)(Random()*K);
+	b=(int)(Random()*K);
+	if((s==t)||(f[a]==g[b])){
+		return(0);
+	}
+	memcpy(u,f,K*sizeof(int));
+	memcpy(w,g,K*sizeof(int));
+	u[a]=g[b];
+	w[b]=f[a];
+	Sort(u);
+	Sort(w);
+	for(n=1;n<K;n++){
+		if((u[n]==u[n-1])||(w[n]==w[n-1])){
+			return(0);
+		}
+	}
+	if((sim[K*SimplexSlot(u)]!=0)||(sim[K*SimplexSlot(w)]!=0)){
+		return(0);
+	}
+	/* The lists of the nodes are not kept up to date during the swaps */
+	Erase(s,0);
+	Erase(SimplexSlot(g),0);
+	memcpy(sim+K*SimplexSlot(u),u,K*sizeof(int));
+	memcpy(sim+K*SimplexSlot(w),w,K*sizeof(int));
+	nsim+=2;
+	return(1);
+}
+/*************************************************************************************************/
+/* Build the lists of the simplices incident to the nodes from the table */
+void Lists(){
+	int i,n;
+	long long s;
+	off[0]=0;
+	for(i=0;i<N;i++){
+		off[i+1]=off[i]+kgi[i]+kg[i];
+		kg[i]=0;
+	}
+	for(s=0;s<=msim;s++){
+		for(n=0;(n<K)&&(sim[K*s]!=0);n++){
+			i=sim[K*s+n]-1;
+			tri[off[i]+kg[i]++]=(int)s;
+		}
+	}
+}
+/*************************************************************************************************/
+/* Generate replica r of the chain. The first one is matched, and the others are swapped from the
+previous one. Then add the diagnostics of the sample */
+void Chain(long r){
+	long long e,acc=0,over=0;
+	if(r==0){
+		Generate();
+		if((figure==0)&&(stats==0)){
+			Edges();
+		}
+		if(K*nsim>mfirst){
+			mfirst=K*nsim;
+			first=(int*)realloc(first,mfirst*sizeof(int));
+		}
+		nfirst=0;
+		for(e=0;e<=msim;e++){
+			if(sim[K*e]!=0){
+				memcpy(first+K*nfirst,sim+K*e,K*sizeof(int));
+				nfirst++;
+			}
+		}
+	}
+	else{
+		PHASE(MATCHING);
+		/* The sample is not matched, so that it has no restarts, back-tracks or repairs of its own */
+		nrestart=0;
+		nrepair=0;
+		nback=0;
+		for(e=0;(e<mcmc)&&(nsim>=2);e++){
+			acc+=Swap();
+		}
+		Lists();
+		Edges();
+	}
+	for(e=0;e<nfirst;e++){
+		over+=(sim[K*SimplexSlot(first+K*e)]!=0);
+	}
+	if(r>=mchain){
+		mchain=2*r+16;
+		cacc=(double*)realloc(cacc,mchain*sizeof(double));
+		cover=(double*)realloc(cover,mchain*sizeof(double));
+		clink=(double*)realloc(clink,mchain*sizeof(double));
+	}
+	cacc[r]=(r>0)?(double)acc/mcmc:0;
+	cover[r]=(nfirst>0)?(double)over/nfirst:0;
+	clink[r]=nedge;
+	if(r>=nchain){
+		nchain=r+1;
+	}
+}
+/*************************************************************************************************/
+/* Print the diagnostics of the chain of the current point to file name, after the line head */
+void PrintChain(const char *name, const char *head){
+	long r,t;
+	double mean=0,var=0,rho,tau=1;
+	FILE *gp;
+	gp=fopen(name,"w");
+	if(gp==NULL){
+		fprintf(stderr,"Cannot open %s\n",name);
+		exit(1);
+	}
+	fprintf(gp,"%s# replica accepted overlap links\n",head);
+	for(r=0;r<nchain;r++){
+		fprintf(gp,"%ld %g %g %.0f\n",r,cacc[r],cover[r],clink[r]);
+		mean+=clink[r]/nchain;
+	}
+	for(r=0;r<nchain;r++){
+		var+=(clink[r]-mean)*(clink[r]-mean)/nchain;
+	}
+	fprintf(gp,"# lag autocorrelation(links)\n");
+	for(t=1;(t<nchain)&&(var>0);t++){
+		rho=0;
+		for(r=0;r+t<nchain;r++){
+			rho+=(clink[r]-mean)*(clink[r+t]-mean);
+		}
+		rho/=(nchain-t)*var;
+		fprintf(gp,"%ld %g\n",t,rho);
+		/* Summed up to the first autocorrelation that is not positive, beyond which it is noise */
+		if(rho<=0){
+			break;
+		}
+		tau+=2*rho;
+	}
+	fprintf(gp,"# tau %g\n",tau);
+	fclose(gp);
+	nchain=0;
+}
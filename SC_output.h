@@ -0,0 +1,167 @@
+/**************************************************************************************************
+ * Buffered writer used by SC.h to print the list of edges. The output is collected in a large buffer
+ * of the thread and written with fwrite when it is full, and integers are formatted by hand instead
+ * of with fprintf.
+ *
+ * With binary=1 the list of edges is written in a compact binary format, which can be memory-mapped
+ * by the programs reading it. All the integers of the header are 64-bit, in the byte order of the
+ * machine that wrote the file:
+ *
+ * magic  The 8 characters "SCEDGES1"
+ * hlen  Length of the text that follows
+ * text  The line starting with # that heads the text format, with the parameters and the seed,
+ *       followed by zeros up to a multiple of 8 bytes so that the integers that follow are aligned
+ * N  Number of nodes
+ * nedge  Number of links, each written once with i<j
+ * nbytes  Length of the data that follows
+ * data  For every link, sorted by i and then by j, the difference between i*N+j and the value for
+ *       the previous link (0 for the first link), as a varint: 7 bits per byte starting from the
+ *       lowest ones, with the highest bit of every byte but the last set to 1
+ *
+ * With streaming=1 the simplices are written to the file name.facets as they are matched, in the text
+ * format of SC_faces.h, after the line starting with # of the replica and followed by a line "# end
+ * point=p replica=r ...", which separate the replicas of a sweep or an ensemble streamed to the same
+ * output. When the matching restarts, what was written since the last commit is discarded: the file
+ * is truncated, or, if the output is a pipe (file=- writes to the standard output) and part of it has
+ * already been sent, a line "# restart" is written, after which the reader should drop the simplices
+ * it has read since the line starting with # before them.
+ *************************************************************************************************/
+
+#define WSIZE (1<<20)  /* Size of the buffer */
+
+_Thread_local FILE *wp;
+_Thread_local char *wbuf;
+_Thread_local long wlen;
+_Thread_local long long wdone,wcommit;  /* Bytes already written to the file, and committed */
+
+/*************************************************************************************************/
+/* Open the file name for writing (the standard output if name is -) */
+void Open(const char *name){
+	wp=(strcmp(name,"-")==0)?stdout:fopen(name,"wb");
+	if(wp==NULL){
+		fprintf(stderr,"Cannot open %s\n",name);
+		exit(1);
+	}
+	if(wbuf==NULL){
+		wbuf=(char*)malloc(WSIZE);
+	}
+	wlen=0;
+	wdone=0;
+	wcommit=0;
+}
+/*************************************************************************************************/
+/* Write the content of the buffer to the file */
+void Flush(){
+	if(fwrite(wbuf,1,wlen,wp)!=(size_t)wlen){
+		fprintf(stderr,"Cannot write the output\n");
+		exit(1);
+	}
+	wdone+=wlen;
+	wlen=0;
+}
+/*************************************************************************************************/
+/* Add n bytes to the buffer */
+void Put(const void *p, long n){
+	if(wlen+n>WSIZE){
+		Flush();
+	}
+	if(n>WSIZE){
+		if(fwrite(p,1,n,wp)!=(size_t)n){
+			fprintf(stderr,"Cannot write the output\n");
+			exit(1);
+		}
+		wdone+=n;
+		return;
+	}
+	memcpy(wbuf+wlen,p,n);
+	wlen+=n;
+}
+/*************************************************************************************************/
+/* Add zeros up to a multiple of 8 bytes from the start of the file */
+void Pad(){
+	static const char zero[8]={0};
+	Put(zero,(8-(wdone+wlen)%8)%8);
+}
+/*************************************************************************************************/
+/* Add x in decimal, followed by the character c */
+static inline void PutInt(unsigned long long x, char c){
+	char s[24];
+	int n=23;
+	if(wlen+24>WSIZE){
+		Flush();
+	}
+	s[n]=c;
+	do{
+		s[--n]='0'+x%10;
+		x/=10;
+	}while(x>0);
+	memcpy(wbuf+wlen,s+n,24-n);
+	wlen+=24-n;
+}
+/*************************************************************************************************/
+/* Add x as a varint */
+static inline void PutVarint(unsigned long long x){
+	if(wlen+10>WSIZE){
+		Flush();
+	}
+	while(x>=0x80){
+		wbuf[wlen++]=(char)(x|0x80);
+		x>>=7;
+	}
+	wbuf[wlen++]=(char)x;
+}
+/*************************************************************************************************/
+/* Number of bytes of x as a varint */
+int VarintLength(unsigned long long x){
+	int n=1;
+	while(x>=0x80){
+		x>>=7;
+		n++;
+	}
+	return(n);
+}
+/*************************************************************************************************/
+/* Write what is left in the buffer and close the file */
+void Close(){
+	Flush();
+	if(wp==stdout){
+		fflush(wp);
+	}
+	else{
+		fclose(wp);
+	}
+}
+/*************************************************************************************************/
+/* Commit what has been written so far, which will not be discarded */
+void Commit(){
+	wcommit=wdone+wlen;
+}
+/*************************************************************************************************/
+/* Discard what has been written since the last commit */
+void Discard(){
+	struct stat st;
+	if(wdone<=wcommit){
+	/* Nothing has left the buffer yet */
+		wlen=wcommit-wdone;
+		return;
+	}
+	Flush();
+	if((fstat(fileno(wp),&st)==0)&&(S_ISREG(st.st_mode))){
+		fflush(wp);
+		if((ftruncate(fileno(wp),wcommit)!=0)||(fseek(wp,wcommit,SEEK_SET)!=0)){
+			fprintf(stderr,"Cannot discard the output\n");
+			exit(1);
+		}
+		wdone=wcommit;
+	}
+	else{
+		Put("# restart\n",10);
+		Commit();
+	}
+}
+/*************************************************************************************************/
+/* Free the buffer of the thread */
+void ReleaseWriter(){
+	free(wbuf);
+	wbuf=NULL;
+}
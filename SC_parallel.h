@@ -0,0 +1,187 @@
+/**************************************************************************************************
+ * Parallel matching of a single simplicial complex, used by SC.h when parallel=1 while more than
+ * PMIN stubs are left, the last ones being matched by Match. The stubs are matched in batches of
+ * proposals: the K stubs of every proposal of a batch are first drawn by all the threads at once
+ * (threads, with R=1), from the Fenwick tree as it was at the start of the batch, and the proposals
+ * are then checked and committed in order by the thread of the replica, as in Match. The tree is
+ * updated once at the end of the batch.
+ *
+ * A stub of node i drawn from the tree of the start of the batch, in which i had w0 unmatched stubs,
+ * is kept with probability kgi[i]/w0, kgi[i] being the stubs of i still unmatched when it is
+ * committed, and otherwise drawn again from the same tree until one is kept. This is rejection
+ * sampling, so that every stub is drawn with probability kgi[i]/xaus among those still unmatched,
+ * exactly as in Match: the complexes have the same distribution as with parallel=0, although they
+ * are not the same complexes. A batch holds xaus/(K PFRAC) proposals, so that about a fraction
+ * 1/PFRAC of the stubs drawn are drawn again. This is checked by parallel.sh, which compiles the
+ * codes with -DPFRAC=2 -DPCHUNK=1 so that the complexes of an ensemble are matched in batches, and
+ * compares the statistics of ensembles generated with parallel=0 and parallel=1 (stats=1).
+ *
+ * Every chunk of PCHUNK proposals is drawn with its own generator, seeded from that of the replica,
+ * so that a complex only depends on the seed and not on the number of threads. The draws take
+ * O(log N) steps each, most of them cache misses, while the commits take O(1) steps per stub besides
+ * the check of the simplex, so that most of the work of the matching is shared among the threads.
+ * The commits remain sequential, which bounds the speedup with many threads.
+ *************************************************************************************************/
+
+#ifndef PFRAC
+#define PFRAC 16  /* Inverse of the fraction of the stubs left drawn in a batch */
+#endif
+#ifndef PCHUNK
+#define PCHUNK 1024  /* Proposals drawn with the same generator */
+#endif
+#define PMIN ((double)K*PFRAC*PCHUNK)  /* Fewest stubs left for which a batch is drawn */
+
+int parallel=0;
+
+_Thread_local int *taken,*drawn,*touch;  /* Stubs of each node taken during the batch, nodes drawn and touched */
+_Thread_local unsigned long long *pseed;  /* Seeds of the chunks of the batch */
+_Thread_local long long mdrawn,mpseed;
+_Thread_local int ntaken;
+
+/* Batch of stubs drawn by the threads */
+struct Batch{
+	int *v;
+	unsigned long long *seed;
+	long long *bit;
+	int nbit;
+	double x;
+	long long next,nchunk;
+	pthread_mutex_t lock;
+};
+
+/*************************************************************************************************/
+/* Thread drawing the stubs of the chunks of a batch it takes, from the tree of the batch, which it
+uses as its own */
+void *Draws(void *arg){
+	struct Batch *b=(struct Batch*)arg;
+	long long c,e;
+	bit=b->bit;
+	nbit=b->nbit;
+	while(1){
+		pthread_mutex_lock(&b->lock);
+		c=b->next++;
+		pthread_mutex_unlock(&b->lock);
+		if(c>=b->nchunk){
+			break;
+		}
+		Seed(rs,b->seed[c]);
+		for(e=(long long)K*PCHUNK*c;e<(long long)K*PCHUNK*(c+1);e++){
+			b->v[e]=Choose(b->x*Random());
+		}
+	}
+	return(NULL);
+}
+/*************************************************************************************************/
+/* Match the stubs in batches as long as more than PMIN are left and fewer than 1+avoid*NX
+back-tracks have been made, and then with Match. The arguments and the output are those of Match */
+static inline double Batches(double xaus, int avoid, int naus, int nrep){
+	int n,t,nt,i,l,v[K];
+	long long e,p,np,ntouch,c;
+	double x0;
+	unsigned long long s[4];
+	struct Batch b;
+	pthread_t tid[MAXTHREADS];
+
+	if((parallel==1)&&(N>ntaken)){
+		ntaken=N;
+		taken=(int*)realloc(taken,ntaken*sizeof(int));
+		memset(taken,0,ntaken*sizeof(int));
+	}
+	for(l=0,t=nbit;t>0;t>>=1,l++);  /* Steps of an update of the tree */
+	while((parallel==1)&&(xaus>=PMIN)&&(naus<1+avoid*NX)){
+		if((journal==1)&&(Now()-tcheck>=checkpoint)){
+			Snapshot(xaus,naus,nrep);
+		}
+		/* Stubs of the batch drawn by the threads */
+		b.nchunk=(long long)(xaus/PMIN);
+		np=b.nchunk*PCHUNK;
+		if(K*np>mdrawn){
+			mdrawn=K*np;
+			drawn=(int*)realloc(drawn,mdrawn*sizeof(int));
+			touch=(int*)realloc(touch,mdrawn*sizeof(int));
+		}
+		if(b.nchunk>mpseed){
+			mpseed=b.nchunk;
+			pseed=(unsigned long long*)realloc(pseed,mpseed*sizeof(unsigned long long));
+		}
+		for(c=0;c<b.nchunk;c++){
+			pseed[c]=Next(rs);
+		}
+		x0=xaus;
+		b.v=drawn;
+		b.seed=pseed;
+		b.bit=bit;
+		b.nbit=nbit;
+		b.x=x0;
+		b.next=0;
+		pthread_mutex_init(&b.lock,NULL);
+		memcpy(s,rs,sizeof(s));
+		nt=(inner<MAXTHREADS)?inner:MAXTHREADS;
+		if(nt>b.nchunk){
+			nt=(int)b.nchunk;
+		}
+		for(t=1;t<nt;t++){
+			pthread_create(&tid[t],NULL,Draws,&b);
+		}
+		Draws(&b);
+		for(t=1;t<nt;t++){
+			pthread_join(tid[t],NULL);
+		}
+		pthread_mutex_destroy(&b.lock);
+		memcpy(rs,s,sizeof(s));
+
+		/* Proposals committed in order */
+		ntouch=0;
+		for(p=0;(p<np)&&(xaus>K)&&(naus<1+avoid*NX);p++){
+			COUNT(nprop);
+			PROGRESS(xaus,naus);
+			for(n=0;n<K;n++){
+				i=drawn[K*p+n];
+				/* Kept with probability kgi[i]/w0, with w0=kgi[i]+taken[i] the stubs of the tree */
+				while(Random()*(kgi[i]+taken[i])>=kgi[i]){
+					i=Choose(x0*Random());
+				}
+				v[n]=i;
+				kg[i]++;
+				kgi[i]--;
+				taken[i]++;
+				touch[ntouch++]=i;
+				xaus--;
+			}
+			if(Check(v)==0){
+				Simplex(v);
+				Journal(1,v,0);
+			}
+			else{
+				naus++;
+				if(avoid==1){
+					for(n=0;n<K;n++){
+						kg[v[n]]--;
+						kgi[v[n]]++;
+						taken[v[n]]--;
+					}
+					xaus+=K;  /* As in Match */
+				}
+				else{
+					Journal(2,v,0);
+				}
+			}
+		}
+		/* Tree updated with the stubs taken, or built again if that takes fewer steps */
+		if((double)ntouch*l>N){
+			Build();
+			for(e=0;e<ntouch;e++){
+				taken[touch[e]]=0;
+			}
+		}
+		else{
+			for(e=0;e<ntouch;e++){
+				if(taken[touch[e]]!=0){
+					Update(touch[e],-taken[touch[e]]);
+					taken[touch[e]]=0;
+				}
+			}
+		}
+	}
+	return(Match(xaus,avoid,naus,nrep));
+}
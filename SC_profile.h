@@ -0,0 +1,95 @@
+/**************************************************************************************************
+ * Instrumentation of the generator, compiled only when PROFILE is defined, for instance with
+ *     gcc -O2 -DPROFILE -pthread -o SC_d3 SC_d3.c -lm
+ * Otherwise the macros below are empty and the generator is unchanged.
+ *
+ * For every replica it counts the proposed simplices, those rejected because two of their nodes
+ * coincide or because the simplex already exists (for D=1, because the link exists), the steps
+ * taken to probe the table of the simplices and the arrays enlarged, and times the phases of the
+ * generation: initialization, matching, links and degrees, analysis and output. A summary is
+ * printed on the standard error at the end of every replica, with the numbers of back-tracks,
+ * restarts and repairs, and with progress=t a line of progress is also printed every t seconds
+ * during the matching.
+ *************************************************************************************************/
+
+enum {INIT,MATCHING,LINKS,ANALYSIS,OUTPUT,NPHASE};
+
+double progress=0;  /* Seconds between two lines of progress (0 for none) */
+
+/*************************************************************************************************/
+/* Seconds since an arbitrary time */
+double Now(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC,&t);
+	return(t.tv_sec+1e-9*t.tv_nsec);
+}
+
+#ifdef PROFILE
+
+_Thread_local long long nprop,nrepeat,nexist,nprobe,ngrow;
+_Thread_local int phase;
+_Thread_local double tphase[NPHASE],tlast,tprogress;
+
+#define COUNT(c) ((c)++)
+#define START() Start()
+#define PHASE(p) Phase(p)
+#define PROGRESS(x,b) if((nprop&0xFFFF)==0){ Progress(x,b); }
+
+/*************************************************************************************************/
+/* Reset the counters and the timers, at the start of a replica */
+void Start(){
+	nprop=0;
+	nrepeat=0;
+	nexist=0;
+	nprobe=0;
+	ngrow=0;
+	memset(tphase,0,sizeof(tphase));
+	phase=INIT;
+	tlast=Now();
+	tprogress=tlast;
+}
+/*************************************************************************************************/
+/* Start phase p, adding the time since the start of the previous phase to that phase */
+void Phase(int p){
+	double t=Now();
+	tphase[phase]+=t-tlast;
+	phase=p;
+	tlast=t;
+}
+/*************************************************************************************************/
+/* Print a line of progress if progress seconds have passed since the last one, with xaus stubs
+left to match and naus back-tracks made by the matching under way */
+void Progress(double xaus, int naus){
+	double t;
+	if(progress<=0){
+		return;
+	}
+	t=Now();
+	if(t-tprogress>=progress){
+		fprintf(stderr,"progress: point %ld proposals %lld simplices %lld stubs left %.0f back-tracks %lld "
+			"restarts %lld\n",point,nprop,nsim,xaus,nback+naus,nrestart);
+		tprogress=t;
+	}
+}
+/*************************************************************************************************/
+/* Print the summary of replica r on the standard error */
+void Profile(long r){
+	Phase(OUTPUT);
+	pthread_mutex_lock(&lock);
+	fprintf(stderr,"profile: point %ld replica %ld proposals %lld rejected %lld (repeated node %lld, existing "
+		"simplex %lld) back-tracks %lld restarts %lld repairs %lld probes %lld grown %lld\n",point,r,nprop,
+		nrepeat+nexist,nrepeat,nexist,nback,nrestart,nrepair,nprobe,ngrow);
+	fprintf(stderr,"profile: point %ld replica %ld seconds init %.6f matching %.6f links %.6f analysis %.6f "
+		"output %.6f\n",point,r,tphase[INIT],tphase[MATCHING],tphase[LINKS],tphase[ANALYSIS],tphase[OUTPUT]);
+	pthread_mutex_unlock(&lock);
+}
+
+#else
+
+#define COUNT(c)
+#define START()
+#define PHASE(p)
+#define PROGRESS(x,b)
+#define Profile(r)
+
+#endif
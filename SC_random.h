@@ -0,0 +1,84 @@
+/**************************************************************************************************
+ * Random number generator of SC.h: xoshiro256++ (D. Blackman and S. Vigna, "Scrambled linear
+ * pseudorandom number generators", ACM Trans. Math. Softw. 47, 36 (2021)).
+ *
+ * Each thread draws from its own state rs. A run is seeded once with Seed(), and the generators of
+ * the replicas are obtained from that state with Jump(), which advances it by 2^128 numbers, so that
+ * the streams of different replicas never overlap.
+ *************************************************************************************************/
+
+_Thread_local unsigned long long rs[4];  /* State of the generator of the thread */
+
+/*************************************************************************************************/
+/* Next number of the splitmix64 sequence of z, used to fill a state of xoshiro256++ from a seed */
+unsigned long long SplitMix(unsigned long long *z){
+	unsigned long long x;
+	x=(*z+=0x9E3779B97F4A7C15ULL);
+	x=(x^(x>>30))*0xBF58476D1CE4E5B9ULL;
+	x=(x^(x>>27))*0x94D049BB133111EBULL;
+	return(x^(x>>31));
+}
+/*************************************************************************************************/
+/* Fill the state s from a 64-bit seed */
+void Seed(unsigned long long *s, unsigned long long seed){
+	int n;
+	for(n=0;n<4;n++){
+		s[n]=SplitMix(&seed);
+	}
+}
+/*************************************************************************************************/
+/* Next 64 random bits of the state s */
+static inline unsigned long long Next(unsigned long long *s){
+	unsigned long long r,t;
+	r=s[0]+s[3];
+	r=((r<<23)|(r>>41))+s[0];
+	t=s[1]<<17;
+	s[2]^=s[0];
+	s[3]^=s[1];
+	s[1]^=s[2];
+	s[0]^=s[3];
+	s[2]^=t;
+	s[3]=(s[3]<<45)|(s[3]>>19);
+	return(r);
+}
+/*************************************************************************************************/
+/* Advance the state s by the number of steps encoded by the polynomial p */
+void Advance(unsigned long long *s, const unsigned long long *p){
+	unsigned long long t[4]={0,0,0,0};
+	int n,b;
+	for(n=0;n<4;n++){
+		for(b=0;b<64;b++){
+			if(p[n]&(1ULL<<b)){
+				t[0]^=s[0];
+				t[1]^=s[1];
+				t[2]^=s[2];
+				t[3]^=s[3];
+			}
+			Next(s);
+		}
+	}
+	memcpy(s,t,sizeof(t));
+}
+/*************************************************************************************************/
+/* Advance the state s by 2^128 numbers */
+void Jump(unsigned long long *s){
+	static const unsigned long long p[4]={0x180ec6d33cfd0abaULL,0xd5a61266f0c9392cULL,
+		0xa9582618e03fc9aaULL,0x39abdc4529b1661cULL};
+	Advance(s,p);
+}
+/*************************************************************************************************/
+/* Random number uniformly distributed in [0,1), from the generator of the thread */
+static inline double Random(){
+	return((Next(rs)>>11)*0x1.0p-53);
+}
+/*************************************************************************************************/
+/* Fill u with n random numbers uniformly distributed in [0,1), from the generator of the thread */
+void Randoms(double *u, long n){
+	long i;
+	unsigned long long s[4];
+	memcpy(s,rs,sizeof(s));
+	for(i=0;i<n;i++){
+		u[i]=(Next(s)>>11)*0x1.0p-53;
+	}
+	memcpy(rs,s,sizeof(s));
+}
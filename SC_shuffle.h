@@ -0,0 +1,250 @@
+/**************************************************************************************************
+ * Matching of the stubs by shuffling, used by SC.h instead of drawing them one at a time with Choose
+ * when shuffle=1. The unmatched stubs are written in an array (node i repeated kgi[i] times), which is
+ * shuffled and cut into consecutive groups of K stubs, each proposed as a simplex in order, until at
+ * most K stubs are left or NX back-tracks have been made, as in Match. The stubs of the simplices
+ * proposed are then read in order instead of being drawn in O(log N) cache misses each.
+ *
+ * The array is shuffled with the scatter shuffle of P. Sanders (Random Struct. Algor. 13, 1 (1998)):
+ * every stub is sent to one of nb buckets chosen at random, and every bucket, of about SBLOCK stubs
+ * so that it fits in the cache, is shuffled with the Fisher-Yates algorithm. Both steps are shared
+ * among threads=... threads (with R=1), the stubs in chunks of the array and the buckets, each with
+ * its own generator seeded from that of the replica, so that the complexes only depend on the seed.
+ *
+ * The simplices are thus proposed in order from a uniformly random arrangement of the stubs left, as
+ * Match draws them. When a proposal is illegal its K stubs are swapped with stubs drawn among those
+ * left, as the Fisher-Yates algorithm would have done, so that the next proposal is again drawn
+ * uniformly among all the stubs left. The complexes are thus not the same as with shuffle=0, but
+ * they have the same distribution, which can be checked by comparing the statistics of two large
+ * ensembles (stats=1, see README). The Fenwick tree is only built again at the end, for the repairs.
+ *
+ * Every time half of the stubs left at the last shuffle have been matched, the stubs left are written
+ * again from kgi and shuffled, which takes O(N) steps and makes the state of the matching depend
+ * only on kgi and the generator. The checkpoints are taken at these times.
+ *************************************************************************************************/
+
+#ifndef SBLOCK
+#define SBLOCK (1<<15)  /* Stubs of a bucket shuffled in the cache */
+#endif
+#define MAXBUCKET 1024  /* Largest number of buckets */
+
+int shuffle=0;
+
+_Thread_local int *stub,*spare;  /* Stubs to be matched, and the array they are sent to */
+_Thread_local unsigned short *label;  /* Bucket of every stub */
+_Thread_local long long nstub,*scount,mscount;  /* Stubs of every chunk in every bucket */
+_Thread_local unsigned long long *sseed;
+
+/* Shuffle of an array shared among threads */
+struct Scatter{
+	int *a,*b;
+	unsigned short *lab;
+	long long n,chunk,nchunk,nb,*cnt,*start;
+	unsigned long long *seed;
+	int step;
+	long long next;
+	pthread_mutex_t lock;
+};
+
+/*************************************************************************************************/
+/* Shuffle the n integers a with the Fisher-Yates algorithm */
+void FisherYates(int *a, long long n){
+	long long e,j;
+	int t;
+	for(e=n-1;e>0;e--){
+		j=(long long)(Random()*(e+1));
+		t=a[e];
+		a[e]=a[j];
+		a[j]=t;
+	}
+}
+/*************************************************************************************************/
+/* Thread doing step 0 (buckets of the stubs of a chunk drawn and counted), 1 (stubs of a chunk sent
+to their buckets) or 2 (buckets shuffled) of a shuffle, for the chunks or buckets it takes */
+void *Scatters(void *arg){
+	struct Scatter *sc=(struct Scatter*)arg;
+	long long c,e,last,*p;
+	while(1){
+		pthread_mutex_lock(&sc->lock);
+		c=sc->next++;
+		pthread_mutex_unlock(&sc->lock);
+		if(c>=((sc->step==2)?sc->nb:sc->nchunk)){
+			break;
+		}
+		if(sc->step==2){
+			Seed(rs,sc->seed[sc->nchunk+c]);
+			FisherYates(sc->b+sc->start[c],sc->start[c+1]-sc->start[c]);
+			continue;
+		}
+		last=(c+1)*sc->chunk;
+		if(last>sc->n){
+			last=sc->n;
+		}
+		p=sc->cnt+c*sc->nb;
+		if(sc->step==0){
+			Seed(rs,sc->seed[c]);
+			memset(p,0,sc->nb*sizeof(long long));
+			for(e=c*sc->chunk;e<last;e++){
+				sc->lab[e]=(unsigned short)(Random()*sc->nb);
+				p[sc->lab[e]]++;
+			}
+		}
+		else{
+			for(e=c*sc->chunk;e<last;e++){
+				sc->b[p[sc->lab[e]]++]=sc->a[e];
+			}
+		}
+	}
+	return(NULL);
+}
+/*************************************************************************************************/
+/* Shuffle the n stubs of stub, using spare, and swap the two arrays so that stub holds the result */
+void Permute(long long n){
+	struct Scatter sc;
+	long long c,b,x,y,start[MAXBUCKET+1];
+	int t,nt,*w;
+	unsigned long long s[4];
+	pthread_t tid[MAXTHREADS];
+
+	sc.nb=n/SBLOCK;
+	if(sc.nb<=1){
+		FisherYates(stub,n);
+		return;
+	}
+	if(sc.nb>MAXBUCKET){
+		sc.nb=MAXBUCKET;
+	}
+	/* Chunks of at least SBLOCK stubs, and at most MAXBUCKET of them */
+	sc.chunk=(n+MAXBUCKET-1)/MAXBUCKET;
+	if(sc.chunk<SBLOCK){
+		sc.chunk=SBLOCK;
+	}
+	sc.nchunk=(n+sc.chunk-1)/sc.chunk;
+	if(sc.nchunk*sc.nb>mscount){
+		mscount=sc.nchunk*sc.nb;
+		scount=(long long*)realloc(scount,mscount*sizeof(long long));
+		sseed=(unsigned long long*)realloc(sseed,(MAXBUCKET+mscount)*sizeof(unsigned long long));
+	}
+	for(c=0;c<sc.nchunk+sc.nb;c++){
+		sseed[c]=Next(rs);
+	}
+	sc.a=stub;
+	sc.b=spare;
+	sc.lab=label;
+	sc.n=n;
+	sc.cnt=scount;
+	sc.start=start;
+	sc.seed=sseed;
+	memcpy(s,rs,sizeof(s));
+	nt=(inner<MAXTHREADS)?inner:MAXTHREADS;
+	pthread_mutex_init(&sc.lock,NULL);
+	for(sc.step=0;sc.step<3;sc.step++){
+		if(sc.step==1){
+		/* Position in spare of the first stub of every chunk in every bucket, the buckets in order */
+			x=0;
+			for(b=0;b<sc.nb;b++){
+				start[b]=x;
+				for(c=0;c<sc.nchunk;c++){
+					y=scount[c*sc.nb+b];
+					scount[c*sc.nb+b]=x;
+					x+=y;
+				}
+			}
+			start[sc.nb]=x;
+		}
+		sc.next=0;
+		for(t=1;t<nt;t++){
+			pthread_create(&tid[t],NULL,Scatters,&sc);
+		}
+		Scatters(&sc);
+		for(t=1;t<nt;t++){
+			pthread_join(tid[t],NULL);
+		}
+	}
+	pthread_mutex_destroy(&sc.lock);
+	memcpy(rs,s,sizeof(s));
+	w=stub;
+	stub=spare;
+	spare=w;
+}
+/*************************************************************************************************/
+/* Write the unmatched stubs in the order of the nodes and shuffle them. Outputs their number */
+long long Stubs(){
+	int i,n;
+	long long e=0;
+	for(i=0;i<N;i++){
+		for(n=0;n<kgi[i];n++){
+			stub[e++]=i;
+		}
+	}
+	Permute(e);
+	return(e);
+}
+/*************************************************************************************************/
+/* Match the stubs by shuffling if shuffle=1, and otherwise with Batches and Match. The arguments and
+the output are those of Match */
+static inline double Deal(double xaus, int avoid, int naus, int nrep){
+	int n,t,v[K];
+	long long e,j,pos;
+	double half;
+
+	if(shuffle==0){
+		return(Batches(xaus,avoid,naus,nrep));
+	}
+	if((long long)xaus>nstub){
+		nstub=(long long)xaus;
+		stub=(int*)realloc(stub,nstub*sizeof(int));
+		spare=(int*)realloc(spare,nstub*sizeof(int));
+		label=(unsigned short*)realloc(label,nstub*sizeof(unsigned short));
+	}
+	Stubs();
+	pos=0;
+	half=xaus/2;
+	/* The stubs left are stub[pos] to stub[pos+xaus-1], in a random order */
+	while((xaus>K)&&(naus<1+avoid*NX)){
+		COUNT(nprop);
+		PROGRESS(xaus,naus);
+		if(xaus<half){
+		/* Half of the stubs matched. The state is then set by kgi and the generator, from which the
+		stubs left are shuffled again */
+			if((journal==1)&&(Now()-tcheck>=checkpoint)){
+				Snapshot(xaus,naus,nrep);
+			}
+			Stubs();
+			pos=0;
+			half=xaus/2;
+		}
+		memcpy(v,stub+pos,K*sizeof(int));
+		for(n=0;n<K;n++){
+			kg[v[n]]++;
+			kgi[v[n]]--;
+		}
+		if(Check(v)==0){
+			Simplex(v);
+			Journal(1,v,0);
+		}
+		else{
+			naus++;
+			if(avoid==1){
+				for(n=0;n<K;n++){
+					kg[v[n]]--;
+					kgi[v[n]]++;
+				}
+				/* Stubs of the proposal shuffled back among those left, as Fisher-Yates would have */
+				for(e=pos;e<pos+K;e++){
+					j=e+(long long)(Random()*(pos+xaus-e));
+					t=stub[e];
+					stub[e]=stub[j];
+					stub[j]=t;
+				}
+				continue;
+			}
+			Journal(2,v,0);
+		}
+		pos+=K;
+		xaus-=K;
+	}
+	Build();
+	nback+=naus;
+	return(xaus);
+}
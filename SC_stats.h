@@ -0,0 +1,226 @@
+/**************************************************************************************************
+ * Statistics of the simplicial complexes, computed by SC.h when stats=1 and averaged over the R
+ * replicas of each point of a sweep:
+ *
+ * P(kg)  Fraction of the nodes with generalized degree kg
+ * P(k)  Fraction of the nodes with degree k
+ * knn(k)  Average degree of the neighbours of the nodes with degree k
+ * C(k)  Average clustering coefficient of the nodes with degree k (0 for k<2)
+ *
+ * The statistics of every replica are computed from its sparse adjacency lists (aoff, adj), in which
+ * the neighbours of node i are adj[aoff[i]] to adj[aoff[i+1]-1] in increasing order, and added to
+ * sums shared by the threads. They are printed in the file name.stats once all the replicas of the
+ * point have been generated, so that the complexes themselves need not be printed (figure=0).
+ * The triangles at each node are counted by intersecting the sorted lists of neighbours of the node
+ * and of each of its neighbours. When the replicas are generated one at a time the nodes are shared
+ * among as many threads as set by threads, in chunks taken in turn so that the hubs do not hold up a
+ * single thread.
+ *************************************************************************************************/
+
+#define CHUNK 256  /* Nodes taken at a time by a thread counting triangles */
+#define MAXTHREADS 256  /* Largest number of threads counting the triangles of a replica */
+
+_Thread_local int *adj;
+_Thread_local long long *aoff,nadj;
+
+/* Sums over the replicas of the current point, shared by the threads: number of nodes with each
+generalized degree (skg) and with each degree (sk), and sums of knn and C over those nodes */
+long long *skg,*sk;
+double *sknn,*sC;
+int nskg,nsk,inner=1;
+long nstat;
+
+/* Range of nodes of a replica shared among the threads counting its triangles */
+struct Share{
+	int *adj;
+	long long *aoff;
+	double *C;
+	int next;
+	pthread_mutex_t lock;
+};
+
+/*************************************************************************************************/
+/* Order of two nodes, used to sort the lists of neighbours */
+int NodeCompare(const void *x, const void *y){
+	return((*(const int*)x>*(const int*)y)-(*(const int*)x<*(const int*)y));
+}
+/*************************************************************************************************/
+/* Build the sorted lists of neighbours of all the nodes from the table of the links, in the arrays
+ao (N+1 offsets) and ad (2*nedge nodes) */
+void Adjacency(long long *ao, int *ad){
+	int i,j;
+	long long e;
+	ao[0]=0;
+	for(i=0;i<N;i++){
+		ao[i+1]=ao[i]+k[i];
+	}
+	for(e=0;e<=medge;e++){
+		if(edge[e]>0){
+			i=(edge[e]-1)/N;
+			j=(edge[e]-1)%N;
+			ad[ao[i]++]=j;
+			ad[ao[j]++]=i;
+		}
+	}
+	for(i=N;i>0;i--){
+		ao[i]=ao[i-1];
+	}
+	ao[0]=0;
+	for(i=0;i<N;i++){
+		qsort(ad+ao[i],ao[i+1]-ao[i],sizeof(int),NodeCompare);
+	}
+}
+/*************************************************************************************************/
+/* Number of nodes in both the sorted lists a (of length na) and b (of length nb) */
+static inline long long Common(const int *a, long long na, const int *b, long long nb){
+	long long x=0,y=0,c=0;
+	while((x<na)&&(y<nb)){
+		if(a[x]<b[y]){
+			x++;
+		}
+		else if(a[x]>b[y]){
+			y++;
+		}
+		else{
+			c++;
+			x++;
+			y++;
+		}
+	}
+	return(c);
+}
+/*************************************************************************************************/
+/* Thread counting the triangles at the nodes of a replica. Sets C[i] to the clustering coefficient
+of node i, for the chunks of nodes it takes */
+void *Triangles(void *arg){
+	struct Share *sh=(struct Share*)arg;
+	int i,first,last;
+	long long x,t,ki;
+	while(1){
+		pthread_mutex_lock(&sh->lock);
+		first=sh->next;
+		sh->next+=CHUNK;
+		pthread_mutex_unlock(&sh->lock);
+		if(first>=N){
+			break;
+		}
+		last=(first+CHUNK<N)?first+CHUNK:N;
+		for(i=first;i<last;i++){
+			ki=sh->aoff[i+1]-sh->aoff[i];
+			t=0;
+			for(x=sh->aoff[i];x<sh->aoff[i+1];x++){
+				t+=Common(sh->adj+sh->aoff[i],ki,sh->adj+sh->aoff[sh->adj[x]],
+					sh->aoff[sh->adj[x]+1]-sh->aoff[sh->adj[x]]);
+			}
+			/* Each triangle at node i is found from both of its other nodes */
+			sh->C[i]=(ki<2)?0:(double)t/(ki*(ki-1.));
+		}
+	}
+	return(NULL);
+}
+/*************************************************************************************************/
+/* Compute the statistics of the replica just generated and add them to the sums of the point */
+void Analyse(){
+	int i,t,nt;
+	long long x;
+	struct Share sh;
+	pthread_t tid[MAXTHREADS];
+
+	if(2*nedge>nadj){
+		COUNT(ngrow);
+		nadj=2*nedge;
+		free(adj);
+		adj=(int*)malloc(nadj*sizeof(int));
+	}
+	Adjacency(aoff,adj);
+	for(i=0;i<N;i++){
+		knn[i]=0;
+		for(x=aoff[i];x<aoff[i+1];x++){
+			knn[i]+=k[adj[x]];
+		}
+		if(k[i]>0){
+			knn[i]/=k[i];
+		}
+	}
+	sh.adj=adj;
+	sh.aoff=aoff;
+	sh.C=Ck;
+	sh.next=0;
+	pthread_mutex_init(&sh.lock,NULL);
+	nt=(inner<MAXTHREADS)?inner:MAXTHREADS;
+	for(t=1;t<nt;t++){
+		pthread_create(&tid[t],NULL,Triangles,&sh);
+	}
+	Triangles(&sh);
+	for(t=1;t<nt;t++){
+		pthread_join(tid[t],NULL);
+	}
+	pthread_mutex_destroy(&sh.lock);
+
+	pthread_mutex_lock(&lock);
+	for(i=0;i<N;i++){
+		if(kg[i]>=nskg){
+			t=nskg;
+			nskg=2*kg[i]+1;
+			skg=(long long*)realloc(skg,nskg*sizeof(long long));
+			memset(skg+t,0,(nskg-t)*sizeof(long long));
+		}
+		skg[kg[i]]++;
+	}
+	if(N>nsk){
+		t=nsk;
+		nsk=N;
+		sk=(long long*)realloc(sk,nsk*sizeof(long long));
+		sknn=(double*)realloc(sknn,nsk*sizeof(double));
+		sC=(double*)realloc(sC,nsk*sizeof(double));
+		memset(sk+t,0,(nsk-t)*sizeof(long long));
+		memset(sknn+t,0,(nsk-t)*sizeof(double));
+		memset(sC+t,0,(nsk-t)*sizeof(double));
+	}
+	for(i=0;i<N;i++){
+		sk[k[i]]++;
+		sknn[k[i]]+=knn[i];
+		sC[k[i]]+=Ck[i];
+	}
+	nstat++;
+	pthread_mutex_unlock(&lock);
+}
+/*************************************************************************************************/
+/* Reset the sums, at the start of a point */
+void ClearStats(){
+	if(nskg>0){
+		memset(skg,0,nskg*sizeof(long long));
+	}
+	if(nsk>0){
+		memset(sk,0,nsk*sizeof(long long));
+		memset(sknn,0,nsk*sizeof(double));
+		memset(sC,0,nsk*sizeof(double));
+	}
+	nstat=0;
+}
+/*************************************************************************************************/
+/* Print the statistics averaged over the replicas of the point to file name, after the line head */
+void PrintStats(const char *name, const char *head){
+	int i;
+	double nn;
+	FILE *gp;
+	gp=fopen(name,"w");
+	if(gp==NULL){
+		fprintf(stderr,"Cannot open %s\n",name);
+		exit(1);
+	}
+	nn=(double)nstat*N;
+	fprintf(gp,"%s# kg P(kg)\n",head);
+	for(i=0;i<nskg;i++){
+		if(skg[i]>0){
+			fprintf(gp,"%d %g\n",i,skg[i]/nn);
+		}
+	}
+	fprintf(gp,"# k P(k) knn(k) C(k)\n");
+	for(i=0;i<nsk;i++){
+		if(sk[i]>0){
+			fprintf(gp,"%d %g %g %g\n",i,sk[i]/nn,sknn[i]/sk[i],sC[i]/sk[i]);
+		}
+	}
+	fclose(gp);
+}
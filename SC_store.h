@@ -0,0 +1,174 @@
+/**************************************************************************************************
+ * Table of the simplices kept in files, used by SC.h when store=dir for complexes whose table does not
+ * fit in memory. The generalized degrees, the Fenwick tree and the other arrays of the nodes stay in
+ * memory, while the table is divided in PARTS files created (and deleted at once, so that nothing is
+ * left behind) in the directory dir, each memory-mapped in its place so that the table is still the
+ * single array sim. As the home slot of a simplex is given by the highest bits of its hash, the file
+ * of a simplex is set by its hash, and the operating system keeps in memory the pages used most and
+ * writes the others to the files.
+ *
+ * Most simplices proposed by the matching do not exist yet. To tell so without reading the table,
+ * every simplex is also added to a Bloom filter kept in memory, with a 64-bit word per 8 slots of the
+ * table, in which BLOOM bits of a single word chosen by the hash of the simplex are set so that a
+ * check takes a single cache miss (F. Putze, P. Sanders and J. Singler, J. Exp. Algorithmics 14, 4.4
+ * (2009)). The simplices are first added to a table of the pending simplices in memory, with
+ * 2^PBITS slots, and they are added to the table in files once it is half full. As both tables probe
+ * from the highest bits of the same hash, the pending simplices are then taken in the order of their
+ * home slots, and the pages of the files are written once each, in order, instead of at random.
+ * A check thus reads the files only when the filter holds the simplex (a simplex that exists, or a
+ * few in 1000 of those that do not at a load factor of 1/2), and the table is written in passes
+ * rather than a page at a time, so that the matching slows down gradually as the table outgrows the
+ * memory instead of waiting for the disk at every simplex.
+ *
+ * Since the slots of the pending simplices are not known, the lists of the simplices incident to the
+ * nodes are not kept, the matching is not repaired (Repair) and mcmc is ignored. The complexes are the
+ * same as with the table in memory, although the simplices may be printed in another order. The
+ * links are kept in memory (figure=1 or stats=1), so that the largest complexes are printed with
+ * figure=0 and facets=1.
+ *************************************************************************************************/
+
+#ifndef PARTS
+#define PARTS 16  /* Files of the table */
+#endif
+#ifndef PBITS
+#define PBITS 20  /* Bits of the number of slots of the table of the pending simplices */
+#endif
+#define SMIN 20  /* Fewest bits of the number of slots of the table in files */
+#define BLOOM 4  /* Bits set in the filter for every simplex */
+
+char store[1024];  /* Directory of the files of the table (empty for the table in memory) */
+
+_Thread_local int smapped,sfd[PARTS],*pend;  /* Table in files, its files, pending simplices */
+_Thread_local unsigned long long *bloom;
+_Thread_local long long npend,mbloom;
+_Thread_local size_t spart;  /* Bytes of a file */
+
+/*************************************************************************************************/
+/* Free the table of the simplices */
+void ReleaseStore(){
+	int p;
+	if(smapped==1){
+		munmap(sim,PARTS*spart);
+		for(p=0;p<PARTS;p++){
+			close(sfd[p]);
+		}
+		free(bloom);
+		free(pend);
+		bloom=NULL;
+		pend=NULL;
+	}
+	else{
+		free(sim);
+	}
+	sim=NULL;
+	smapped=0;
+}
+/*************************************************************************************************/
+/* Allocate a table of 2^b slots for the simplices, in memory or, if store is set, in files of the
+directory store (with at least 2^SMIN slots) */
+void Table(int b){
+	char name[sizeof(store)+32];
+	char *base;
+	int p;
+	ReleaseStore();
+	if(store[0]==0){
+		sim=(int*)malloc(K*(1LL<<b)*sizeof(int));
+	}
+	else{
+		if(b<SMIN){
+			b=SMIN;
+		}
+		spart=K*(1LL<<b)*sizeof(int)/PARTS;
+		/* Addresses of the whole table reserved, and each file mapped in its place */
+		base=(char*)mmap(NULL,PARTS*spart,PROT_NONE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+		if(base==MAP_FAILED){
+			fprintf(stderr,"Cannot map the table of the simplices\n");
+			exit(1);
+		}
+		for(p=0;p<PARTS;p++){
+			snprintf(name,sizeof(name),"%s/SC_simplices_XXXXXX",store);
+			sfd[p]=mkstemp(name);
+			if((sfd[p]<0)||(unlink(name)!=0)||(ftruncate(sfd[p],spart)!=0)||
+				(mmap(base+p*spart,spart,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_FIXED,sfd[p],0)==MAP_FAILED)){
+				fprintf(stderr,"Cannot create the table of the simplices in %s\n",store);
+				exit(1);
+			}
+		}
+		sim=(int*)base;
+		mbloom=(1LL<<(b-3))-1;
+		bloom=(unsigned long long*)malloc((mbloom+1)*sizeof(unsigned long long));
+		pend=(int*)calloc(K*(1LL<<PBITS),sizeof(int));
+		npend=0;
+		smapped=1;
+	}
+	sbits=b;
+	msim=(1LL<<b)-1;
+}
+/*************************************************************************************************/
+/* Remove all the simplices from the table in files. The files are emptied, which frees their pages
+without writing them */
+void ClearStore(){
+	int p;
+	for(p=0;p<PARTS;p++){
+		if((ftruncate(sfd[p],0)!=0)||(ftruncate(sfd[p],spart)!=0)){
+			fprintf(stderr,"Cannot clear the table of the simplices\n");
+			exit(1);
+		}
+	}
+	memset(bloom,0,(mbloom+1)*sizeof(unsigned long long));
+	memset(pend,0,K*(1LL<<PBITS)*sizeof(int));
+	npend=0;
+}
+/*************************************************************************************************/
+/* Word of the filter of the simplex of hash h, in which the bits *w are set for the simplex */
+static inline unsigned long long *Filter(unsigned long long h, unsigned long long *w){
+	int n;
+	h^=h>>29;
+	h*=0xBF58476D1CE4E5B9ULL;
+	h^=h>>32;
+	*w=0;
+	for(n=0;n<BLOOM;n++){
+		*w|=1ULL<<((h>>(6*n))&63);
+	}
+	return(bloom+((h>>24)&mbloom));
+}
+/*************************************************************************************************/
+/* Add the pending simplices to the table in files, in the order of their home slots */
+void Merge(){
+	long long s;
+	for(s=0;s<(1LL<<PBITS);s++){
+		if(pend[K*s]!=0){
+			memcpy(sim+K*SimplexSlot(pend+K*s),pend+K*s,K*sizeof(int));
+		}
+	}
+	memset(pend,0,K*(1LL<<PBITS)*sizeof(int));
+	npend=0;
+}
+/*************************************************************************************************/
+/* Add the shifted simplex u, which does not exist, to the pending simplices and to the filter */
+static inline void Store(const int *u){
+	unsigned long long h,w,*f;
+	h=Hash(u);
+	f=Filter(h,&w);
+	*f|=w;
+	memcpy(pend+K*Probe(pend,(1LL<<PBITS)-1,(long long)(h>>(64-PBITS)),u),u,K*sizeof(int));
+	npend++;
+	if(2*npend>=(1LL<<PBITS)){
+		Merge();
+	}
+}
+/*************************************************************************************************/
+/* Outputs 1 if the shifted simplex u exists and 0 otherwise, looking for it in the table in files
+only if the filter and the pending simplices do not tell */
+static inline int Stored(const int *u){
+	unsigned long long h,w,*f;
+	h=Hash(u);
+	f=Filter(h,&w);
+	if((*f&w)!=w){
+		return(0);
+	}
+	if(pend[K*Probe(pend,(1LL<<PBITS)-1,(long long)(h>>(64-PBITS)),u)]!=0){
+		return(1);
+	}
+	return(sim[K*SimplexSlot(u)]!=0);
+}
@@ -0,0 +1,25 @@
+#!/bin/sh
+###################################################################################################
+# Benchmark of the generators of simplicial complexes of dimension 1 to 5, over a grid of N and
+# gamma2 with a fixed seed. Each code is compiled with the flags in CFLAGS (default -O2) and run
+# with bench=1 (see SC_bench.h), which checks every complex and prints one line of JSON for it:
+#     ./bench.sh > bench.json
+# The stuck matchings are repaired (Repair=1000, see SC.h) so that the largest complexes are
+# generated without restarting over and over. Other parameters are passed to every run, for
+# instance ./bench.sh R=4 Repair=0, and the grid can be changed with the variables NS and GAMMAS.
+###################################################################################################
+
+set -e
+cd "$(dirname "$0")"
+CFLAGS=${CFLAGS:--O2}
+NS=${NS:-1000,10000,100000,1000000}
+GAMMAS=${GAMMAS:-2.5,2.8}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+for d in 1 2 3 4 5; do
+	gcc $CFLAGS -pthread -o "$dir/SC_d$d" SC_d$d.c -lm
+done
+for d in 1 2 3 4 5; do
+	"$dir/SC_d$d" bench=1 figure=0 seed=1 Repair=1000 N=$NS gamma2=$GAMMAS "$@"
+done
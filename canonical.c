@@ -0,0 +1,157 @@
+/**************************************************************************************************
+ * Check of the canonical ensemble (SC_canonical.h), compiled for a dimension d by canonical.sh as
+ *     gcc -O2 -DLIBRARY -DD=d -pthread -o canonical canonical.c -lm
+ *
+ * The nodes are given fixed hidden variables theta, spread over several groups of SC_canonical.h with
+ * several nodes each, and the generalized degrees of R complexes generated by Canonical are averaged.
+ * They are compared with the expected generalized degrees, the sums of the probabilities p of all the
+ * C(N,K) possible simplices of each node, and the check fails if one differs by more than 5 standard
+ * deviations of the average, or if a complex has a repeated simplex. It also checks that Unrank gives
+ * every subset once, in increasing order, and that Binomial is exact (by the identity of Pascal) up to
+ * the largest coefficients that fit in 128 bits and reports the larger ones, for instance C(10^7,6).
+ * Outputs 0 if all the checks pass and 1 otherwise.
+ *************************************************************************************************/
+
+#ifndef D
+#define D 2
+#endif
+
+int N=14;
+int m=1;
+double gamma2=2.5;
+double lambda=10;
+int Avoid=1;
+int NX=15;
+int figure=0;
+
+#include "SC.h"
+
+#define NREP 20000  /* Complexes averaged */
+
+/* Hidden variables, within a factor 2 of each other in groups of 2 to 4 nodes */
+const int hidden[14]={40,36,30,18,17,16,15,9,8,5,4,4,2,1};
+
+/*************************************************************************************************/
+/* Outputs 1 if Unrank numbers the subsets of r elements of 0 to n-1 in colexicographic order */
+int Subsets(long long n, int r){
+	long long w[K],prev[K],idx,total;
+	int j,c;
+	total=(long long)Binomial(n,r);
+	for(idx=0;idx<total;idx++){
+		Unrank(idx,n,r,w);
+		for(j=0;j<r;j++){
+			if((w[j]<0)||(w[j]>=n)||((j>0)&&(w[j]<=w[j-1]))){
+				return(0);
+			}
+		}
+		if(idx>0){
+			/* Colexicographic order: the last element that differs is larger */
+			for(j=r-1;(j>=0)&&(w[j]==prev[j]);j--);
+			c=(j>=0)&&(w[j]>prev[j]);
+			if(c==0){
+				return(0);
+			}
+		}
+		memcpy(prev,w,sizeof(w));
+	}
+	return(1);
+}
+/*************************************************************************************************/
+int main(){
+	int i,n,v[K],fail=0;
+	long r,c;
+	long long s;
+	double sum,scale,p,x,expect[14],var[14],mean[14];
+	unsigned __int128 b;
+
+	/* Binomial coefficients */
+	for(n=1;n<=6;n++){
+		for(s=n+1;s<=20000000;s=s*3/2+1){
+			b=Binomial(s,n);
+			if(b==BIG){
+				break;
+			}
+			if(Binomial(s-1,n)+Binomial(s-1,n-1)!=b){
+				printf("D=%d Binomial(%lld,%d) wrong\n",D,s,n);
+				fail=1;
+			}
+		}
+	}
+	if(Binomial(10000000,6)!=BIG){
+		printf("D=%d Binomial(10^7,6) does not report the overflow\n",D);
+		fail=1;
+	}
+	/* Numbering of the subsets */
+	for(n=1;n<=K;n++){
+		if(Subsets(12,n)==0){
+			printf("D=%d Unrank(.,12,%d) wrong\n",D,n);
+			fail=1;
+		}
+	}
+
+	/* Expected generalized degrees, from all the possible simplices */
+	sum=0;
+	for(i=0;i<N;i++){
+		sum+=hidden[i];
+		expect[i]=0;
+		var[i]=0;
+		mean[i]=0;
+	}
+	scale=1;
+	for(n=1;n<=D;n++){
+		scale=scale*n/sum;
+	}
+	for(n=0;n<K;n++){
+		v[n]=n;
+	}
+	while(1){
+		p=scale;
+		for(n=0;n<K;n++){
+			p*=hidden[v[n]];
+		}
+		p=(p<1)?p:1;
+		for(n=0;n<K;n++){
+			expect[v[n]]+=p;
+			var[v[n]]+=p*(1-p);
+		}
+		for(n=D;(n>=0)&&(v[n]==N-K+n);n--);
+		if(n<0){
+			break;
+		}
+		v[n]++;
+		for(c=n+1;c<K;c++){
+			v[c]=v[c-1]+1;
+		}
+	}
+
+	/* Average generalized degrees of the complexes generated */
+	Seed(rs,1);
+	Allocate();
+	for(r=0;r<NREP;r++){
+		for(i=0;i<N;i++){
+			kgi[i]=hidden[i];
+		}
+		Canonical();
+		/* A repeated simplex would take the slot of the first one */
+		c=0;
+		for(s=0;s<=msim;s++){
+			c+=(sim[K*s]!=0);
+		}
+		if(c!=ncs){
+			printf("D=%d repeated simplex\n",D);
+			fail=1;
+		}
+		for(i=0;i<N;i++){
+			mean[i]+=(double)kg[i]/NREP;
+		}
+	}
+	for(i=0;i<N;i++){
+		x=fabs(mean[i]-expect[i]);
+		if(x>5*sqrt(var[i]/NREP)+1e-9*expect[i]){
+			printf("D=%d node %d theta %d average kg %g expected %g\n",D,i,hidden[i],mean[i],expect[i]);
+			fail=1;
+		}
+	}
+	printf("D=%d %s\n",D,(fail==0)?"ok":"failed");
+	return(fail);
+}
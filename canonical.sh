@@ -0,0 +1,22 @@
+#!/bin/sh
+###################################################################################################
+# Check of the canonical ensemble (canonical=1, see SC_canonical.h) in dimension 1 to 5. For every
+# dimension canonical.c is compiled with the flags in CFLAGS (default -O2) and run, which compares
+# the average generalized degrees of complexes generated with fixed hidden variables with those
+# computed from all the possible simplices, and checks the numbering of the candidates:
+#     ./canonical.sh
+# Prints one line per dimension and fails if a check fails.
+###################################################################################################
+
+set -e
+cd "$(dirname "$0")"
+CFLAGS=${CFLAGS:--O2}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+fail=0
+for d in 1 2 3 4 5; do
+	gcc $CFLAGS -DLIBRARY -DD=$d -pthread -o "$dir/canonical_d$d" canonical.c -lm
+	"$dir/canonical_d$d" || fail=1
+done
+exit $fail
@@ -0,0 +1,222 @@
+/**************************************************************************************************
+ * Microbenchmarks of the steps of the matching, compiled for a dimension d by micro.sh as
+ *     gcc -O2 -DLIBRARY -DD=d -pthread -o micro micro.c -lm
+ * and run with the name of a benchmark:
+ *
+ * ./micro choose  Time of a stub drawn with Choose from the Fenwick tree of the unmatched stubs (and
+ *     put back with Update), against the linear scan of kgi of the original codes, for N=10^3 to 10^6
+ *     nodes with the generalized degrees of the scale-free distribution. Both give the same node for
+ *     every random number, which is checked.
+ * ./micro check   Time of a simplex proposed with a hub of generalized degree h=10 to 10^5 checked
+ *     with Check and the table of the simplices, against the scan of the list of the simplices of the
+ *     hub of the original codes, among N=10^6 nodes. Half of the proposals are simplices of the hub,
+ *     with their nodes in random order, and the other half random nodes with the hub, and both give
+ *     the same answer for every proposal, which is checked.
+ *
+ * Every measure is printed as a line of JSON, with the time of a step in nanoseconds. Outputs 1 if
+ * a check fails and 0 otherwise.
+ *************************************************************************************************/
+
+#ifndef D
+#define D 1
+#endif
+
+int N=1000;
+int m=1;
+double gamma2=2.5;
+double lambda=10;
+int Avoid=1;
+int NX=15;
+int figure=0;
+
+#include "SC.h"
+
+/*************************************************************************************************/
+/* Node of the stub x among the unmatched stubs kgi, found by scanning the nodes as the original codes */
+int Scan(double x){
+	int i;
+	for(i=0;i<N;i++){
+		x-=kgi[i];
+		if(x<0){
+			break;
+		}
+	}
+	return(i);
+}
+/*************************************************************************************************/
+/* Stubs drawn with the Fenwick tree and with the linear scan */
+int Sampler(){
+	int i,j,fail=0;
+	long d,nd,ns;
+	long long sum;
+	double t0,t1,t2,*x;
+	for(N=1000;N<=1000000;N*=10){
+		Allocate();
+		Degrees(Cutoff());
+		Build();
+		sum=0;
+		for(i=0;i<N;i++){
+			sum+=kgi[i];
+		}
+		/* Random numbers drawn in advance, so that only the draws are timed */
+		nd=2000000;
+		ns=(long)(2e8/N);
+		x=(double*)malloc(nd*sizeof(double));
+		for(d=0;d<nd;d++){
+			x[d]=sum*Random();
+		}
+		t0=Now();
+		j=0;
+		for(d=0;d<nd;d++){
+			i=Choose(x[d]);
+			Update(i,-1);
+			Update(i,1);
+			j+=i;
+		}
+		t1=Now();
+		for(d=0;d<ns;d++){
+			j-=Scan(x[d]);
+		}
+		t2=Now();
+		for(d=0;d<ns;d++){
+			if(Choose(x[d])!=Scan(x[d])){
+				fail=1;
+			}
+		}
+		printf("{\"bench\": \"choose\", \"N\": %d, \"stubs\": %lld, \"fenwick_ns\": %.1f, \"scan_ns\": %.1f, "
+			"\"same\": %s, \"sink\": %d}\n",N,sum,1e9*(t1-t0)/nd,1e9*(t2-t1)/ns,(fail==0)?"true":"false",j&1);
+		free(x);
+	}
+	return(fail);
+}
+/*************************************************************************************************/
+/* Outputs 1 if the proposed simplex v has a repeated node or is in the list of its first node, by
+scanning the list as the original codes. Sorts v. */
+int Listed(int *v){
+	int n,c,u[K];
+	long long j,s;
+	int i=v[0];
+	Sort(v);
+	for(n=1;n<K;n++){
+		if(v[n]==v[n-1]){
+			return(1);
+		}
+	}
+	for(n=0;n<K;n++){
+		u[n]=v[n]+1;
+	}
+	for(j=off[i];j<off[i]+kg[i];j++){
+		s=tri[j];
+		c=0;
+		for(n=0;n<K;n++){
+			c|=(sim[K*s+n]!=u[n]);
+		}
+		if(c==0){
+			return(1);
+		}
+	}
+	return(0);
+}
+/*************************************************************************************************/
+/* Simplices proposed with a hub, checked with the table and by scanning the list of the hub */
+int Hubs(){
+	int i,n,h,j,*w,*p,v[K],u[K],fail=0;
+	long d,np,ns;
+	double t0,t1,t2;
+	N=1000000;
+	Allocate();
+	np=1000000;
+	p=(int*)malloc(np*K*sizeof(int));
+	for(h=10;h<=100000;h*=10){
+		/* h distinct simplices of the hub, node 0, and random nodes */
+		w=(int*)malloc(h*K*sizeof(int));
+		memset(kgi,0,N*sizeof(int));
+		ClearSimplices(h);
+		for(j=0;j<h;){
+			v[0]=0;
+			for(n=1;n<K;n++){
+				v[n]=1+(int)((N-1)*Random());
+			}
+			if(Check(v)==0){
+				/* Only in the table, as the lists are not laid out yet */
+				for(n=0;n<K;n++){
+					u[n]=v[n]+1;
+				}
+				memcpy(sim+K*SimplexSlot(u),u,K*sizeof(int));
+				memcpy(w+K*j,v,K*sizeof(int));
+				for(n=0;n<K;n++){
+					kgi[v[n]]++;
+				}
+				j++;
+			}
+		}
+		/* The simplices again, in the lists of their nodes */
+		ClearSimplices(h);
+		Layout();
+		memset(kg,0,N*sizeof(int));
+		for(j=0;j<h;j++){
+			for(n=0;n<K;n++){
+				kg[w[K*j+n]]++;
+			}
+			Simplex(w+K*j);
+		}
+		/* Proposals, the hub first and the other nodes in random order */
+		for(d=0;d<np;d++){
+			j=(int)(h*Random());
+			for(n=0;n<K;n++){
+				p[K*d+n]=((d&1)==0)?w[K*j+n]:((n==0)?0:(int)(N*Random()));
+			}
+			for(n=K-1;n>1;n--){
+				j=1+(int)(n*Random());
+				i=p[K*d+n];
+				p[K*d+n]=p[K*d+j];
+				p[K*d+j]=i;
+			}
+		}
+		ns=(long)(2e8/h);
+		ns=(ns<np)?ns:np;
+		t0=Now();
+		j=0;
+		for(d=0;d<np;d++){
+			memcpy(v,p+K*d,K*sizeof(int));
+			j+=Check(v);
+		}
+		t1=Now();
+		for(d=0;d<ns;d++){
+			memcpy(v,p+K*d,K*sizeof(int));
+			j-=Listed(v);
+		}
+		t2=Now();
+		for(d=0;d<ns;d++){
+			memcpy(v,p+K*d,K*sizeof(int));
+			i=Check(v);
+			memcpy(v,p+K*d,K*sizeof(int));
+			if(i!=Listed(v)){
+				fail=1;
+			}
+		}
+		printf("{\"bench\": \"check\", \"D\": %d, \"hub\": %d, \"check_ns\": %.1f, \"scan_ns\": %.1f, "
+			"\"same\": %s, \"sink\": %d}\n",D,h,1e9*(t1-t0)/np,1e9*(t2-t1)/ns,(fail==0)?"true":"false",j&1);
+		free(w);
+	}
+	free(p);
+	return(fail);
+}
+/*************************************************************************************************/
+int main(int argc, char **argv){
+	int a,fail=0;
+	Seed(rs,1);
+	for(a=1;a<argc;a++){
+		if(strcmp(argv[a],"choose")==0){
+			fail|=Sampler();
+		}
+		else if(strcmp(argv[a],"check")==0){
+			fail|=Hubs();
+		}
+		else{
+			fprintf(stderr,"Unknown benchmark %s\n",argv[a]);
+			return(1);
+		}
+	}
+	return(fail);
+}
@@ -0,0 +1,24 @@
+#!/bin/sh
+###################################################################################################
+# Microbenchmarks of the steps of the matching (see micro.c), compiled with the flags in CFLAGS
+# (default -O2), each printing one line of JSON per measure:
+#     ./micro.sh > micro.json
+# choose times a stub drawn from the Fenwick tree of the unmatched stubs against the linear scan of
+# the original codes, for N=10^3 to 10^6, and check times a simplex proposed with a hub checked with
+# the table of the simplices against the scan of the list of the hub of the original codes, for hubs
+# of generalized degree 10 to 10^5 in dimension 2 and 3. Fails if the two do not give the same answers.
+###################################################################################################
+
+set -e
+cd "$(dirname "$0")"
+CFLAGS=${CFLAGS:--O2}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+for d in 1 2 3; do
+	gcc $CFLAGS -DLIBRARY -DD=$d -pthread -o "$dir/micro_d$d" micro.c -lm
+done
+"$dir/micro_d1" choose
+for d in 2 3; do
+	"$dir/micro_d$d" check
+done
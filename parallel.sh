@@ -0,0 +1,54 @@
+#!/bin/sh
+###################################################################################################
+# Check of the parallel matching (parallel=1, see SC_parallel.h) for the codes of dimension 1, 2 and
+# 3. The batches are only drawn while more than PMIN=K*PFRAC*PCHUNK stubs are left (65536 in
+# dimension 3), far more than the complexes of a large ensemble have, so that each code is compiled
+# with the flags in CFLAGS (default -O2) and -DPFRAC=2 -DPCHUNK=1, which draws batches down to 2K
+# stubs. Ensembles of R replicas are then generated with parallel=0 and parallel=1 and stats=1:
+#     ./parallel.sh
+# The check fails if the two .stats files are the same (no batch was drawn), if the total variation
+# distance between their P(kg) or their P(k) is larger than TVMAX, or if the relative difference
+# between their averages of knn(k) is larger than KNNMAX or that of C(k) larger than CMAX (see
+# stats.awk), the seed being the same. With N=1000 and R=4000, five seeds give at most 0.0006, 0.009
+# and 0.02, while keeping every stub drawn from the tree of the start of the batch gives a knn(k)
+# differing by 0.018 to 0.06. It also fails if a single complex (R=1) matched with parallel=1 differs
+# between threads=1 and threads=4. N, R, TVMAX, KNNMAX and CMAX can be changed as variables.
+###################################################################################################
+
+set -e
+cd "$(dirname "$0")"
+CFLAGS=${CFLAGS:--O2}
+N=${N:-1000}
+R=${R:-4000}
+TVMAX=${TVMAX:-0.005}
+KNNMAX=${KNNMAX:-0.015}
+CMAX=${CMAX:-0.04}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+fail=0
+for d in 1 2 3; do
+	gcc $CFLAGS -DPFRAC=2 -DPCHUNK=1 -pthread -o "$dir/SC_d$d" SC_d$d.c -lm
+	for p in 0 1; do
+		"$dir/SC_d$d" stats=1 figure=0 seed=1 N=$N R=$R gamma2=3 parallel=$p file="$dir/d${d}_p$p.txt" > /dev/null
+	done
+	if cmp -s "$dir/d${d}_p0.stats" "$dir/d${d}_p1.stats"; then
+		echo "d=$d: no batch was drawn"
+		fail=1
+	fi
+	set -- $(awk -f stats.awk "$dir/d${d}_p0.stats" "$dir/d${d}_p1.stats")
+	if awk "BEGIN{exit !(($1>$TVMAX)||($2>$TVMAX)||($3>$KNNMAX)||($4>$CMAX))}"; then
+		echo "d=$d: parallel=1 differs from parallel=0: P(kg) $1 P(k) $2 knn $3 C $4"
+		fail=1
+	else
+		echo "d=$d: parallel=1 differs from parallel=0: P(kg) $1 P(k) $2 knn $3 C $4, ok"
+	fi
+	for t in 1 4; do
+		"$dir/SC_d$d" seed=1 N=$((N*20)) gamma2=3 parallel=1 threads=$t file="$dir/d${d}_t$t.txt" > /dev/null
+	done
+	if ! cmp -s "$dir/d${d}_t1.txt" "$dir/d${d}_t4.txt"; then
+		echo "d=$d: the complex depends on the number of threads"
+		fail=1
+	fi
+done
+exit $fail
@@ -0,0 +1,64 @@
+#!/bin/sh
+###################################################################################################
+# Check of the repairs and restarts of the matching (Repair and Restart, see Generate in SC.h) for
+# the codes of dimension 1, 2 and 3. Each code is compiled with the flags in CFLAGS (default -O2), and
+# an ensemble of R replicas is generated with Repair=0, Repair=1000, Repair=0 Restart=1 and Repair=1
+# Restart=1, with bench=1 (see SC_bench.h) and stats=1:
+#     ./repair.sh
+# The check fails if a complex is not valid (no repeated simplex or node, generalized degrees as
+# desired), if the runs with repairs have no repair or those with Restart=1 no restart, or if the
+# statistics of a run differ from those of Repair=0 (see stats.awk): the total variation distance
+# between their P(kg) or their P(k) larger than TVMAX, or the relative difference between their
+# averages of knn(k) larger than KNNMAX or that of C(k) larger than CMAX, the seed being the same.
+#
+# The generalized degrees follow a Poisson distribution and NX=3, so that the matching gets stuck
+# often but every degree sequence can be matched. With scale-free distributions Restart=1 keeps the
+# hardest sequences, whose matching can then take very long, and Repair=0 Restart=0 drops them, which
+# changes knn(k) by itself (by 8% with gamma2=3.5 and NX=3 against NX=1000, with almost no restart).
+# With N=1000 and R=1000, three seeds give at most 0.003, 0.0015 and 0.05 (C(k) in dimension 1, with
+# few triangles). N, R, LAMBDA, TVMAX, KNNMAX and CMAX can be changed as variables.
+###################################################################################################
+
+set -e
+cd "$(dirname "$0")"
+CFLAGS=${CFLAGS:--O2}
+N=${N:-1000}
+R=${R:-1000}
+LAMBDA=${LAMBDA:-4}
+TVMAX=${TVMAX:-0.005}
+KNNMAX=${KNNMAX:-0.005}
+CMAX=${CMAX:-0.08}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+fail=0
+for d in 1 2 3; do
+	gcc $CFLAGS -pthread -o "$dir/SC_d$d" SC_d$d.c -lm
+	for run in "Repair=0" "Repair=1000" "Repair=0 Restart=1" "Repair=1 Restart=1"; do
+		name=$(echo "$run" | tr -d ' =')
+		"$dir/SC_d$d" bench=1 stats=1 figure=0 seed=1 N=$N R=$R degrees=poisson lambda=$LAMBDA NX=3 \
+			file="$dir/d${d}_$name.txt" $run > "$dir/d${d}_$name.json"
+		if grep -q '"valid": false' "$dir/d${d}_$name.json"; then
+			echo "d=$d $run: invalid complexes"
+			fail=1
+		fi
+		restarts=$(grep -o '"restarts": [0-9]*' "$dir/d${d}_$name.json" | awk '{s+=$2} END{print s+0}')
+		repairs=$(grep -o '"repairs": [0-9]*' "$dir/d${d}_$name.json" | awk '{s+=$2} END{print s+0}')
+		case "$run" in
+		*Restart=1*) [ "$restarts" -gt 0 ] || { echo "d=$d $run: no restart"; fail=1; } ;;
+		esac
+		case "$run" in
+		Repair=1*) [ "$repairs" -gt 0 ] || { echo "d=$d $run: no repair"; fail=1; } ;;
+		esac
+		[ "$name" = Repair0 ] && continue
+		set -- $(awk -f stats.awk "$dir/d${d}_Repair0.stats" "$dir/d${d}_$name.stats")
+		if awk "BEGIN{exit !(($1>$TVMAX)||($2>$TVMAX)||($3>$KNNMAX)||($4>$CMAX))}"; then
+			result=""
+			fail=1
+		else
+			result=", ok"
+		fi
+		echo "d=$d $run: $restarts restarts $repairs repairs, differs from Repair=0: P(kg) $1 P(k) $2 knn $3 C $4$result"
+	done
+done
+exit $fail
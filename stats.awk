@@ -0,0 +1,22 @@
+###################################################################################################
+# Distance between the statistics of two ensembles, given by their .stats files (stats=1):
+#     awk -f stats.awk a.stats b.stats
+# prints the total variation distances between their P(kg) and between their P(k), and the relative
+# differences between their averages of knn(k) and of C(k) over the nodes, with the weight P(k).
+###################################################################################################
+
+FNR==1{f++}
+/^# kg /{s=1; next}
+/^# k /{s=2; next}
+/^#/{next}
+s==1{pg[f,$1]=$2; kg[$1]=1}
+s==2{pk[f,$1]=$2; knn[f,$1]=$3; C[f,$1]=$4; k[$1]=1}
+function abs(x){return (x<0)?-x:x}
+END{
+	for(i in kg){tg+=abs(pg[1,i]-pg[2,i])}
+	for(i in k){
+		tk+=abs(pk[1,i]-pk[2,i])
+		for(j=1;j<=2;j++){n[j]+=pk[j,i]*knn[j,i]; c[j]+=pk[j,i]*C[j,i]}
+	}
+	printf "%.4f %.4f %.4f %.4f\n",tg/2,tk/2,(n[1]>0)?abs(n[1]-n[2])/n[1]:0,(c[1]>0)?abs(c[1]-c[2])/c[1]:0
+}